@@ -0,0 +1,119 @@
+#include "battery_policy.h"
+#include "watchface.h"
+#include "render_scheduler.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static BatteryLevel s_level     = BatteryLevelNormal;
+static uint8_t      s_percent   = 100;
+static bool         s_connected = true;
+
+// Work skipped since launch
+static uint32_t s_skipped_seconds_ms = 0;
+static uint32_t s_skipped_icons      = 0;
+static uint32_t s_skipped_refreshes  = 0;
+static bool     s_icon_hidden        = false;  // icon left out since the last normal frame
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+static const char* level_name(BatteryLevel level) {
+  switch (level) {
+    case BatteryLevelLow:      return "low";
+    case BatteryLevelCritical: return "critical";
+    default:                   return "normal";
+  }
+}
+
+static void log_skipped(void) {
+  APP_LOG(APP_LOG_LEVEL_INFO,
+          "Battery policy: %s at %d%%, %s; skipped %lu ms seconds, %lu icon draws, %lu refreshes",
+          level_name(s_level), s_percent, s_connected ? "connected" : "disconnected",
+          (unsigned long)s_skipped_seconds_ms, (unsigned long)s_skipped_icons,
+          (unsigned long)s_skipped_refreshes);
+}
+
+static BatteryLevel level_for(BatteryChargeState charge) {
+  if (charge.is_charging || charge.is_plugged)           return BatteryLevelNormal;
+  if (charge.charge_percent <= BATTERY_CRITICAL_PERCENT) return BatteryLevelCritical;
+  if (charge.charge_percent <  BATTERY_LOW_PERCENT)      return BatteryLevelLow;
+  return BatteryLevelNormal;
+}
+
+// ============================================================================
+// PRIVATE: SERVICE CALLBACKS
+// ============================================================================
+
+static void battery_handler(BatteryChargeState charge) {
+  s_percent = charge.charge_percent;
+  BatteryLevel level = level_for(charge);
+  if (level == s_level) return;
+  s_level = level;
+  log_skipped();
+
+  // An icon left out for lack of a cached bitmap comes back on the next frame
+  if (level == BatteryLevelNormal && s_icon_hidden) {
+    s_icon_hidden = false;
+    render_invalidate(RenderDepWeather);
+  }
+}
+
+static void app_connection_handler(bool connected) {
+  s_connected = connected;
+  log_skipped();
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void battery_policy_init(void) {
+  s_connected = connection_service_peek_pebble_app_connection();
+  battery_handler(battery_state_service_peek());
+  battery_state_service_subscribe(battery_handler);
+  connection_service_subscribe((ConnectionHandlers) {
+    .pebble_app_connection_handler = app_connection_handler,
+  });
+}
+
+BatteryLevel battery_policy_level(void) {
+  return s_level;
+}
+
+uint32_t battery_policy_seconds_duration(void) {
+  switch (s_level) {
+    case BatteryLevelLow:      return BATTERY_LOW_SECONDS_MS;
+    case BatteryLevelCritical: return 0;
+    default:                   return SECONDS_DISPLAY_DURATION;
+  }
+}
+
+bool battery_policy_icon_cache_only(void) {
+  return s_level != BatteryLevelNormal;
+}
+
+bool battery_policy_connected(void) {
+  return s_connected;
+}
+
+void battery_policy_skipped_seconds(uint32_t ms) {
+  s_skipped_seconds_ms += ms;
+}
+
+void battery_policy_skipped_icon(void) {
+  s_skipped_icons++;
+  s_icon_hidden = true;
+}
+
+void battery_policy_skipped_refresh(void) {
+  s_skipped_refreshes++;
+}
+
+void battery_policy_deinit(void) {
+  battery_state_service_unsubscribe();
+  connection_service_unsubscribe();
+  log_skipped();
+}
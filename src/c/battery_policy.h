@@ -0,0 +1,45 @@
+#pragma once
+#include <pebble.h>
+
+// Battery policy — owns the battery and phone connection subscriptions and
+// gates the optional work by charge level (never while charging):
+//   - below BATTERY_LOW_PERCENT shake-to-show seconds run for
+//     BATTERY_LOW_SECONDS_MS, and the weather icon is only blitted from its
+//     cache, never drawn from primitives or rasterized
+//   - at or below BATTERY_CRITICAL_PERCENT a shake shows no seconds at all
+//   - while the phone app is disconnected, weather refreshes are held back
+// The work skipped is counted and logged on every level or connection
+// change, and at exit.
+
+#define BATTERY_LOW_PERCENT       30
+#define BATTERY_CRITICAL_PERCENT  10
+#define BATTERY_LOW_SECONDS_MS    3000
+
+typedef enum {
+  BatteryLevelNormal = 0,
+  BatteryLevelLow,
+  BatteryLevelCritical,
+} BatteryLevel;
+
+// Subscribes to the battery and connection services. Call from init
+void battery_policy_init(void);
+
+BatteryLevel battery_policy_level(void);
+
+// How long a shake shows seconds, in ms — 0 while seconds are disabled
+uint32_t battery_policy_seconds_duration(void);
+
+// True if the weather icon may only come from its cached bitmap
+bool battery_policy_icon_cache_only(void);
+
+// True while the phone app is connected
+bool battery_policy_connected(void);
+
+// Skipped-work counters, reported by the policy's log line: ms of seconds
+// display a shake did not get, icon draws left out, refresh requests held back
+void battery_policy_skipped_seconds(uint32_t ms);
+void battery_policy_skipped_icon(void);
+void battery_policy_skipped_refresh(void);
+
+// Unsubscribes and logs the final counts — call from deinit
+void battery_policy_deinit(void);
@@ -0,0 +1,224 @@
+#include "bench.h"
+
+#if defined(WATCHFACE_BENCH)
+#include "watchface.h"
+
+// ============================================================================
+// PRIVATE CONSTANTS
+// ============================================================================
+
+#define BENCH_REPEATS      50    // passes over all 60 angles per measurement
+#define BENCH_START_DELAY  1000  // ms — let the first frames render undisturbed
+
+// Screen sizes of every target platform, so one device can time them all
+static const BenchResolution RESOLUTIONS[] = {
+  { "144x168", 144, 168 },  // aplite, basalt, diorite, flint
+  { "180x180", 180, 180 },  // chalk
+  { "200x228", 200, 228 },  // emery
+  { "260x260", 260, 260 },  // gabbro
+};
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static volatile int32_t s_sink;  // keeps results alive so calls aren't optimized out
+static GRect            s_bounds;
+
+// ============================================================================
+// TIMING — also used by the render benchmarks in the layer modules
+// ============================================================================
+
+uint32_t bench_now_ms(void) {
+  time_t   s;
+  uint16_t ms;
+  time_ms(&s, &ms);
+  return (uint32_t)s * 1000 + ms;
+}
+
+void bench_report(const char *what, const char *res, uint32_t elapsed_ms, uint32_t calls) {
+  uint32_t ns = (uint32_t)((uint64_t)elapsed_ms * 1000000 / calls);
+  APP_LOG(APP_LOG_LEVEL_INFO, "bench %-22s %s: %lu ns/call (%lu calls, %lu ms)",
+          what, res, (unsigned long)ns, (unsigned long)calls, (unsigned long)elapsed_ms);
+}
+
+// ============================================================================
+// PRIVATE: MICROBENCHMARKS — one pass each, returning the calls made
+// ============================================================================
+
+static uint32_t bench_rounded_rect(const BenchResolution *r) {
+  int w_radius = r->w / 2 - 2;
+  int h_radius = r->h / 2 - 2;
+  for (int n = 0; n < BENCH_REPEATS; n++) {
+    for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+      GPoint p = get_point_on_rounded_rect(degrees_to_trig_angle(i * 6),
+                                           w_radius, h_radius, SQR_WATCHFACE_RADIOUS);
+      s_sink += p.x + p.y;
+    }
+  }
+  return BENCH_REPEATS * MINUTE_MARKER_COUNT;
+}
+
+static uint32_t bench_rect(const BenchResolution *r) {
+  int w_radius = r->w / 2 - 2;
+  int h_radius = r->h / 2 - 2;
+  for (int n = 0; n < BENCH_REPEATS; n++) {
+    for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+      GPoint p = get_point_on_rect(degrees_to_trig_angle(i * 6), w_radius, h_radius);
+      s_sink += p.x + p.y;
+    }
+  }
+  return BENCH_REPEATS * MINUTE_MARKER_COUNT;
+}
+
+static uint32_t bench_circle(const BenchResolution *r) {
+  int radius = r->w / 2 - 2;
+  for (int n = 0; n < BENCH_REPEATS; n++) {
+    for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+      GPoint p = get_point_on_circle(degrees_to_trig_angle(i * 6), radius);
+      s_sink += p.x + p.y;
+    }
+  }
+  return BENCH_REPEATS * MINUTE_MARKER_COUNT;
+}
+
+// Same magnitudes the corner solve feeds isqrt: (r - cross) * (r + cross)
+// with r = SQR_WATCHFACE_RADIOUS * TRIG_MAX_RATIO
+static uint32_t bench_isqrt(const BenchResolution *r) {
+  uint32_t r_trig = (uint32_t)SQR_WATCHFACE_RADIOUS * TRIG_MAX_RATIO;
+  for (int n = 0; n < BENCH_REPEATS; n++) {
+    for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+      uint32_t cross = r_trig / MINUTE_MARKER_COUNT * i;
+      s_sink += (int32_t)isqrt((uint64_t)(r_trig - cross) * (r_trig + cross));
+    }
+  }
+  return BENCH_REPEATS * MINUTE_MARKER_COUNT;
+}
+
+// Layout work the weather and date widgets do when they build their text
+static uint32_t bench_weather_text(const BenchResolution *r) {
+  static char buffer[8];
+  GFont font = s_watchface.text_font;
+  for (int n = 0; n < BENCH_REPEATS * 4; n++) {
+    snprintf(buffer, sizeof(buffer), "%d" "\xc2\xb0" "C", n % 100 - 50);
+    GSize size = graphics_text_layout_get_content_size(
+      buffer, font, GRect(0, 0, 56, 26),
+      GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft
+    );
+    s_sink += size.w;
+  }
+  return BENCH_REPEATS * 4;
+}
+
+static uint32_t bench_date_text(const BenchResolution *r) {
+  static char buffer[8];
+  for (int n = 0; n < BENCH_REPEATS * 4; n++) {
+    snprintf(buffer, sizeof(buffer), "%s-%d", "WED", n % 31 + 1);
+    s_sink += buffer[4];
+  }
+  return BENCH_REPEATS * 4;
+}
+
+static const BenchCase CASES[] = {
+  { "get_point_on_rounded_rect", true,  bench_rounded_rect },
+  { "get_point_on_rect",         true,  bench_rect },
+  { "get_point_on_circle",       true,  bench_circle },
+  { "isqrt",                     true,  bench_isqrt },
+  { "weather text measure",      false, bench_weather_text },
+  { "date snprintf",             false, bench_date_text },
+};
+
+// ============================================================================
+// PRIVATE: PIXEL CHECKS — caches against the direct math
+// ============================================================================
+
+static int count_mismatch(const char *what, int index, GPoint cached, GPoint direct) {
+  if (gpoint_equal(&cached, &direct)) return 0;
+  APP_LOG(APP_LOG_LEVEL_WARNING, "bench MISMATCH %s[%d]: cached (%d,%d) direct (%d,%d)",
+          what, index, cached.x, cached.y, direct.x, direct.y);
+  return 1;
+}
+
+int bench_check_geometry(GRect bounds) {
+  int face_w     = FACE_W_RADIUS - (CLOCK_FACE_STROKE_WIDTH / 2);
+  int face_h     = FACE_H_RADIUS - (CLOCK_FACE_STROKE_WIDTH / 2);
+  int hour_len   = s_watchface.radius * HOUR_HAND_LENGTH_PCT / 100;
+  int minute_len = s_watchface.radius * MINUTE_HAND_LENGTH_PCT / 100;
+  int second_len = s_watchface.radius * SECOND_HAND_LENGTH_PCT / 100;
+  int bad = 0;
+
+  for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+    int32_t angle = degrees_to_trig_angle(i * 6);
+    int     len   = is_major_marker(i) ? MAJOR_MARKER_LENGTH : MINOR_MARKER_LENGTH;
+
+    bad += count_mismatch("marker_outer", i, s_face_geometry.marker_outer[i],
+                          get_point_on_face(angle, face_w, face_h));
+    bad += count_mismatch("marker_inner", i, s_face_geometry.marker_inner[i],
+                          get_point_on_face(angle, face_w - len, face_h - len));
+    bad += count_mismatch("minute_end", i, s_hands_geometry.minute_end[i],
+                          get_point_on_circle(angle, minute_len));
+    bad += count_mismatch("second_end", i, s_hands_geometry.second_end[i],
+                          get_point_on_circle(angle, second_len));
+  }
+
+  for (int d = 0; d < HOUR_HAND_POSITIONS; d++) {
+    bad += count_mismatch("hour_end", d, s_hands_geometry.hour_end[d],
+                          get_point_on_circle(degrees_to_trig_angle(d), hour_len));
+  }
+
+  #if defined(WATCHFACE_SMOOTH_SECONDS)
+  for (int p = 0; p < SWEEP_HAND_POSITIONS; p++) {
+    int32_t angle = degrees_to_trig_angle(p * 360 / SWEEP_HAND_POSITIONS);
+    bad += count_mismatch("sweep_end", p, s_hands_geometry.sweep_end[p],
+                          get_point_on_circle(angle, second_len));
+  }
+  #endif
+
+  APP_LOG(APP_LOG_LEVEL_INFO, "bench geometry check %dx%d: %s (%d mismatches)",
+          bounds.size.w, bounds.size.h, bad ? "FAIL" : "OK", bad);
+  return bad;
+}
+
+// ============================================================================
+// PRIVATE: DRIVER
+// ============================================================================
+
+static void time_case(const BenchCase *c, const BenchResolution *r) {
+  uint32_t start = bench_now_ms();
+  uint32_t calls = c->run(r);
+  bench_report(c->name, r ? r->name : "-", bench_now_ms() - start, calls);
+}
+
+static void bench_timer_callback(void *context) {
+  APP_LOG(APP_LOG_LEVEL_INFO, "bench start");
+  bench_check_geometry(s_bounds);
+  for (int i = 0; i < bench_case_count(); i++) {
+    if (!CASES[i].per_resolution) {
+      time_case(&CASES[i], NULL);
+      continue;
+    }
+    for (unsigned r = 0; r < ARRAY_LENGTH(RESOLUTIONS); r++) {
+      time_case(&CASES[i], &RESOLUTIONS[r]);
+    }
+  }
+  APP_LOG(APP_LOG_LEVEL_INFO, "bench done");
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void bench_run(GRect bounds) {
+  s_bounds = bounds;
+  app_timer_register(BENCH_START_DELAY, bench_timer_callback, NULL);
+}
+
+int bench_case_count(void) {
+  return ARRAY_LENGTH(CASES);
+}
+
+const BenchCase* bench_case(int index) {
+  return &CASES[index];
+}
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+#include <pebble.h>
+
+// On-device microbenchmarks for the geometry and layout code.
+// Only compiled in with WATCHFACE_BENCH=1 (see wscript); otherwise a no-op.
+//
+// Times every projection helper over all 60 marker angles for each known
+// platform resolution, reports ns/call over APP_LOG, and checks the geometry
+// caches (runtime or generated const tables) against the direct math pixel
+// for pixel so perf work can't quietly shift markers.
+//
+// Render-path benchmarks need a GContext, so they live next to the code
+// they time (e.g. layer_hands.c) and report through bench_report.
+//
+// The cases and the pixel check are also driven from the host
+// (tools/host_bench.py, on the tools/host_render shim), which times the
+// same loops with a nanosecond clock and the CPU's instruction counter.
+#if defined(WATCHFACE_BENCH)
+typedef struct {
+  const char *name;
+  int16_t     w, h;
+} BenchResolution;
+
+// One microbenchmark pass over the code under test for a screen of r's
+// size; returns the number of calls it made. Cases that do not depend on
+// the screen (per_resolution false) are run with r == NULL
+typedef struct {
+  const char *name;
+  bool        per_resolution;
+  uint32_t  (*run)(const BenchResolution *r);
+} BenchCase;
+
+void bench_run(GRect bounds);
+uint32_t bench_now_ms(void);
+void bench_report(const char *what, const char *res, uint32_t elapsed_ms, uint32_t calls);
+
+int              bench_case_count(void);
+const BenchCase* bench_case(int index);
+
+// Checks every geometry cache entry (runtime or generated tables) against
+// the direct math for bounds, logs each mismatch and returns their count
+int bench_check_geometry(GRect bounds);
+#else
+static inline void bench_run(GRect bounds) { }
+#endif
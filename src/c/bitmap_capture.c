@@ -0,0 +1,177 @@
+#include "bitmap_capture.h"
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+// 1-bit rows are LSB-first: pixel x lives in bit (x % 8) of byte (x / 8)
+static void copy_row_1bit(const uint8_t *src, int src_x, uint8_t *dst, int dst_x, int w) {
+  if ((src_x % 8) == 0 && (dst_x % 8) == 0) {
+    memcpy(dst + dst_x / 8, src + src_x / 8, (w + 7) / 8);
+    return;
+  }
+  for (int i = 0; i < w; i++) {
+    int sx = src_x + i;
+    int dx = dst_x + i;
+    if (src[sx / 8] & (1 << (sx % 8))) {
+      dst[dx / 8] |=  (1 << (dx % 8));
+    } else {
+      dst[dx / 8] &= ~(1 << (dx % 8));
+    }
+  }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+GBitmapFormat bitmap_capture_format(void) {
+  return PBL_IF_COLOR_ELSE(GBitmapFormat8Bit, GBitmapFormat1Bit);
+}
+
+GRect bitmap_capture_screen_rect(const Layer *layer, GRect local) {
+  for (const Layer *l = layer; l; l = layer_get_parent(l)) {
+    GRect frame  = layer_get_frame(l);
+    GRect bounds = layer_get_bounds(l);
+    local.origin.x += frame.origin.x + bounds.origin.x;
+    local.origin.y += frame.origin.y + bounds.origin.y;
+  }
+  return local;
+}
+
+bool bitmap_capture_frame(GContext *ctx, GRect src, GBitmap *dest) {
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) return false;
+
+  bool  one_bit  = (gbitmap_get_format(fb) == GBitmapFormat1Bit);
+  GRect fb_rect  = gbitmap_get_bounds(fb);
+
+  // A partial copy would leave stale rows in a cache that is reused later
+  if (src.origin.x < 0 || src.origin.y < 0 ||
+      src.origin.x + src.size.w > fb_rect.size.w ||
+      src.origin.y + src.size.h > fb_rect.size.h) {
+    graphics_release_frame_buffer(ctx, fb);
+    return false;
+  }
+  GSize dst_size = gbitmap_get_bounds(dest).size;
+  int   w        = (src.size.w < dst_size.w) ? src.size.w : dst_size.w;
+  int   h        = (src.size.h < dst_size.h) ? src.size.h : dst_size.h;
+
+  for (int y = 0; y < h; y++) {
+    int sy = src.origin.y + y;
+    if (sy < 0 || sy >= fb_rect.size.h) continue;
+
+    // Row info handles both rectangular and circular (chalk) frame buffers
+    GBitmapDataRowInfo s = gbitmap_get_data_row_info(fb, sy);
+    GBitmapDataRowInfo d = gbitmap_get_data_row_info(dest, y);
+    int x0 = (src.origin.x > s.min_x) ? src.origin.x : s.min_x;
+    int x1 = (src.origin.x + w - 1 < s.max_x) ? src.origin.x + w - 1 : s.max_x;
+    if (x1 < x0) continue;
+
+    if (one_bit) {
+      copy_row_1bit(s.data, x0, d.data, x0 - src.origin.x, x1 - x0 + 1);
+    } else {
+      memcpy(d.data + (x0 - src.origin.x), s.data + x0, x1 - x0 + 1);
+    }
+  }
+
+  graphics_release_frame_buffer(ctx, fb);
+  return true;
+}
+
+#if defined(PBL_COLOR)
+// Palettized rows are MSB-first: pixel 0 sits in the top bits of byte 0
+static int palette_bits(GBitmap *bitmap) {
+  switch (gbitmap_get_format(bitmap)) {
+    case GBitmapFormat1BitPalette: return 1;
+    case GBitmapFormat2BitPalette: return 2;
+    case GBitmapFormat4BitPalette: return 4;
+    default:                       return 0;
+  }
+}
+
+static inline uint8_t get_index(const uint8_t *row, int x, int bits) {
+  int per_byte = 8 / bits;
+  int shift    = 8 - bits * (x % per_byte + 1);
+  return (row[x / per_byte] >> shift) & ((1 << bits) - 1);
+}
+
+static inline void set_index(uint8_t *row, int x, int bits, uint8_t index) {
+  int     per_byte = 8 / bits;
+  int     shift    = 8 - bits * (x % per_byte + 1);
+  uint8_t mask     = ((1 << bits) - 1) << shift;
+  row[x / per_byte] = (row[x / per_byte] & ~mask) | ((index << shift) & mask);
+}
+
+bool bitmap_capture_palettized(GContext *ctx, GRect src, GBitmap *dest,
+                               const GColor *keys, int key_count) {
+  int bits = palette_bits(dest);
+  if (!bits) return false;
+
+  GBitmap *fb = graphics_capture_frame_buffer(ctx);
+  if (!fb) return false;
+
+  GRect fb_rect = gbitmap_get_bounds(fb);
+  if (src.origin.x < 0 || src.origin.y < 0 ||
+      src.origin.x + src.size.w > fb_rect.size.w ||
+      src.origin.y + src.size.h > fb_rect.size.h) {
+    graphics_release_frame_buffer(ctx, fb);
+    return false;
+  }
+
+  GSize    dst_size = gbitmap_get_bounds(dest).size;
+  uint8_t *dst_data = gbitmap_get_data(dest);
+  uint16_t stride   = gbitmap_get_bytes_per_row(dest);
+  int      w        = (src.size.w < dst_size.w) ? src.size.w : dst_size.w;
+  int      h        = (src.size.h < dst_size.h) ? src.size.h : dst_size.h;
+
+  for (int y = 0; y < h; y++) {
+    uint8_t *d = dst_data + y * stride;
+    memset(d, 0, stride);
+
+    GBitmapDataRowInfo s = gbitmap_get_data_row_info(fb, src.origin.y + y);
+    int x0 = (src.origin.x > s.min_x) ? src.origin.x : s.min_x;
+    int x1 = (src.origin.x + w - 1 < s.max_x) ? src.origin.x + w - 1 : s.max_x;
+
+    for (int x = x0; x <= x1; x++) {
+      uint8_t argb = s.data[x];
+      for (int i = 1; i < key_count; i++) {
+        if (argb == keys[i].argb) {
+          set_index(d, x - src.origin.x, bits, i);
+          break;
+        }
+      }
+    }
+  }
+
+  graphics_release_frame_buffer(ctx, fb);
+  return true;
+}
+
+void bitmap_remap_index(GBitmap *bitmap, GRect rect, uint8_t from, uint8_t to) {
+  int bits = palette_bits(bitmap);
+  if (!bits) return;
+
+  GRect    bounds = gbitmap_get_bounds(bitmap);
+  uint8_t *data   = gbitmap_get_data(bitmap);
+  uint16_t stride = gbitmap_get_bytes_per_row(bitmap);
+  grect_clip(&rect, &bounds);
+
+  for (int y = rect.origin.y; y < rect.origin.y + rect.size.h; y++) {
+    uint8_t *row = data + y * stride;
+    for (int x = rect.origin.x; x < rect.origin.x + rect.size.w; x++) {
+      if (get_index(row, x, bits) == from) set_index(row, x, bits, to);
+    }
+  }
+}
+
+void bitmap_make_transparent(GBitmap *bitmap, GColor key) {
+  GRect bounds = gbitmap_get_bounds(bitmap);
+  for (int y = 0; y < bounds.size.h; y++) {
+    GBitmapDataRowInfo row = gbitmap_get_data_row_info(bitmap, y);
+    for (int x = row.min_x; x <= row.max_x; x++) {
+      if (row.data[x] == key.argb) row.data[x] = GColorClear.argb;
+    }
+  }
+}
+#endif
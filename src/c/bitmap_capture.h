@@ -0,0 +1,36 @@
+#pragma once
+#include <pebble.h>
+
+// Pebble can't draw into an offscreen GBitmap, so caches are filled by drawing
+// into the frame buffer during a render pass and copying the result out.
+
+// Copies the frame buffer region src (window coordinates) into dest starting
+// at dest's (0,0). dest must have the frame buffer's bit depth (1-bit on B&W,
+// 8-bit on color — circular frame buffers copy into plain 8-bit). Pixels
+// outside a round display's visible span are left untouched.
+// Must be called from inside an update proc. Returns false if the frame
+// buffer could not be captured or src is not entirely on screen (e.g. while
+// a timeline peek has pushed the face partly off the top).
+bool bitmap_capture_frame(GContext *ctx, GRect src, GBitmap *dest);
+
+// Maps local, a rect in layer's own coordinates, to window coordinates by
+// walking up the layer tree
+GRect bitmap_capture_screen_rect(const Layer *layer, GRect local);
+
+// The format an offscreen copy of the frame buffer should be created with
+GBitmapFormat bitmap_capture_format(void);
+
+#if defined(PBL_COLOR)
+// Like bitmap_capture_frame, but converts into a palettized dest (1, 2 or
+// 4 bit): a pixel equal to keys[i] becomes palette index i, anything else
+// index 0. Draw with antialiasing off so every pixel is exactly a key.
+bool bitmap_capture_palettized(GContext *ctx, GRect src, GBitmap *dest,
+                               const GColor *keys, int key_count);
+
+// Rewrites palette index from to index to inside rect (bitmap coordinates)
+void bitmap_remap_index(GBitmap *bitmap, GRect rect, uint8_t from, uint8_t to);
+
+// Makes every pixel of color key fully transparent, so the bitmap can be
+// drawn with GCompOpSet over other content
+void bitmap_make_transparent(GBitmap *bitmap, GColor key);
+#endif
@@ -0,0 +1,60 @@
+#include "compositor.h"
+#include "layer_face.h"
+#include "layer_date.h"
+#include "layer_hands.h"
+#include "layer_seconds.h"
+#include "layer_weather.h"
+
+#if defined(WATCHFACE_COMPOSITOR)
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static Layer *s_composite_layer;
+static Layer *s_stash_layer;
+
+// Bottom to top, the order the same layers stack in without the compositor.
+// Each pass skips itself until its layer exists, so the secondary layers
+// join once their startup stage has run
+static const LayerUpdateProc s_passes[] = {
+  face_layer_composite,
+  date_layer_composite,
+  hands_layer_composite,
+  seconds_layer_composite,
+  weather_layer_composite,
+};
+
+// ============================================================================
+// LAYER UPDATE PROC — one context for the whole frame
+// ============================================================================
+
+static void composite_update_proc(Layer *layer, GContext *ctx) {
+  for (unsigned i = 0; i < ARRAY_LENGTH(s_passes); i++) {
+    s_passes[i](layer, ctx);
+  }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+Layer* compositor_create(GRect bounds, Layer *parent) {
+  s_composite_layer = layer_create(bounds);
+  layer_set_update_proc(s_composite_layer, composite_update_proc);
+  layer_add_child(parent, s_composite_layer);
+
+  s_stash_layer = layer_create(bounds);
+  layer_set_hidden(s_stash_layer, true);
+  layer_add_child(parent, s_stash_layer);
+  return s_stash_layer;
+}
+
+void compositor_destroy(void) {
+  layer_destroy(s_stash_layer);
+  layer_destroy(s_composite_layer);
+  s_stash_layer     = NULL;
+  s_composite_layer = NULL;
+}
+
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+#include <pebble.h>
+
+// Single-layer compositor, only compiled in with WATCHFACE_COMPOSITOR=1
+// (see wscript; it can be limited to some platforms). The module
+// layers are still created — they keep their frames, visibility and render
+// scheduler registrations — but hang off a hidden stash layer, so the
+// firmware never traverses, clips or resets the context for them. One
+// full-screen layer draws them instead, in the usual stacking order: the
+// cached face, date, hands, second hand, then the weather widget.
+// layer_mark_dirty on any module layer still schedules the window's frame.
+
+// Creates the compositing layer and the stash inside parent. Create the
+// watchface layers with the returned stash as their parent
+Layer* compositor_create(GRect bounds, Layer *parent);
+
+// Destroys both layers — call after the module layers have been destroyed
+void compositor_destroy(void);
@@ -0,0 +1,81 @@
+#include "layer_date.h"
+#include "watchface.h"
+#include "profile.h"
+#include "render_scheduler.h"
+#include "theme.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static Layer *s_date_layer;
+static char   s_date_buffer[8];  // "SAT-31\0"
+
+// ============================================================================
+// LAYER UPDATE PROC — draws the cached text, nothing else
+// ============================================================================
+
+static void draw_date(GContext *ctx, GRect rect) {
+  uint32_t start = profile_begin();
+
+  graphics_context_set_text_color(ctx, theme_get()->accent);
+  graphics_draw_text(ctx, s_date_buffer, s_watchface.text_font,
+                     rect, GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
+
+  profile_end(ProfileLayerDate, start);
+}
+
+static void date_update_proc(Layer *layer, GContext *ctx) {
+  draw_date(ctx, layer_get_bounds(layer));
+}
+
+// Compositor pass — the text goes where the layer's frame is
+void date_layer_composite(Layer *target, GContext *ctx) {
+  if (!s_date_layer || layer_get_hidden(s_date_layer)) return;
+  draw_date(ctx, layer_get_frame(s_date_layer));
+}
+
+// ============================================================================
+// RENDER SCHEDULER HOOK
+// ============================================================================
+
+static void format_date(struct tm *now) {
+  static const char * const WEEKDAYS[] = {
+    "SUN","MON","TUE","WED","THU","FRI","SAT"
+  };
+  snprintf(s_date_buffer, sizeof(s_date_buffer), "%s-%d",
+           WEEKDAYS[now->tm_wday], now->tm_mday);
+}
+
+static bool date_refresh(struct tm *now, uint32_t changed) {
+  format_date(now);
+  return true;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+Layer* date_layer_create(GRect bounds, Layer *parent) {
+  // Centered vertically between the center dot and the "6" label (see watchface.c)
+  s_date_layer = layer_create(s_widget_geometry.date_rect);
+  layer_set_update_proc(s_date_layer, date_update_proc);
+  layer_add_child(parent, s_date_layer);
+
+  format_date(watchface_localtime());
+  render_register(s_date_layer, RenderDepDay | RenderDepTheme, date_refresh);
+  return s_date_layer;
+}
+
+void date_layer_move(GRect frame) {
+  if (!s_date_layer) return;
+  bool hidden = frame.size.h == 0;
+  if (!hidden) layer_set_frame(s_date_layer, frame);
+  layer_set_hidden(s_date_layer, hidden);
+}
+
+void date_layer_destroy(void) {
+  render_unregister(s_date_layer);
+  layer_destroy(s_date_layer);
+  s_date_layer = NULL;
+}
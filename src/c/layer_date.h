@@ -0,0 +1,19 @@
+#pragma once
+#include <pebble.h>
+
+// Creates the date widget layer ("SAT-31") between the center dot and the
+// "6" label. Sits below the hands layer so the hands pass over it.
+// The text is formatted only when the day changes (via the render
+// scheduler); frames just draw it.
+Layer* date_layer_create(GRect bounds, Layer *parent);
+
+// Moves the layer to frame, a rect from watchface_fit_widgets; GRectZero
+// hides it until a frame that fits comes back
+void date_layer_move(GRect frame);
+
+// Draws the date at the layer's frame into target, a layer in the same
+// coordinates as the date layer's parent (compositor.h)
+void date_layer_composite(Layer *target, GContext *ctx);
+
+// Destroys the date layer — call from main_window_unload
+void date_layer_destroy(void);
@@ -1,72 +1,80 @@
 #include "layer_face.h"
 #include "watchface.h"
+#include "profile.h"
+#include "bitmap_capture.h"
+#include "render_scheduler.h"
+#include "theme.h"
 
 // ============================================================================
 // PRIVATE STATE — not visible outside this module
 // ============================================================================
 
-static Layer *s_face_layer;
-static int s_active_hour = -1;
+// Palette slots of the cached face. On color platforms the face is cached as
+// a 2-bit palettized bitmap: the theme lives entirely in s_face_palette and
+// the highlighted hour is just which label pixels use FaceInkLabelActive
+typedef enum {
+  FaceInkBackground = 0,
+  FaceInkRing,
+  FaceInkLabel,
+  FaceInkLabelActive,
+  FaceInkCount,
+} FaceInk;
 
+#if defined(PBL_COLOR)
+// Unique colors the face is rasterized with, so the capture can tell the
+// palette slots apart. Never shown on screen
+static const GColor FACE_KEYS[FaceInkCount] = {
+  { .argb = GColorBlackARGB8 },
+  { .argb = GColorWhiteARGB8 },
+  { .argb = GColorBlueARGB8 },
+  { .argb = GColorRedARGB8 },
+};
 
-// ============================================================================
-// PRIVATE HELPERS
-// ============================================================================
+static GColor s_face_palette[FaceInkCount];  // referenced, not copied, by s_face_bitmap
+#endif
 
-static int get_face_w_edge(void) {
-  return s_w_radius - (CLOCK_FACE_STROKE_WIDTH / 2);
-}
+static Layer   *s_face_layer;
+static int      s_active_hour = -1;
+static GBitmap *s_face_bitmap     = NULL;   // offscreen copy of the rasterized face
+static bool     s_face_cached     = false;  // true once s_face_bitmap holds a valid frame
+static bool     s_face_warm       = false;  // set by face_layer_warm_cache; capture allowed
+static bool     s_capture_blocked = false;  // the capture at s_blocked_rect failed
+static GRect    s_blocked_rect;             // window rect of the last capture
 
-static int get_face_h_edge(void) {
-  return s_h_radius - (CLOCK_FACE_STROKE_WIDTH / 2);
-}
 
 // ============================================================================
 // PRIVATE DRAWING FUNCTIONS
 // ============================================================================
 
-static void draw_clock_face(GContext *ctx) {
-  graphics_context_set_stroke_color(ctx, GColorWhite);
+static void draw_clock_face(GContext *ctx, const GColor *inks) {
+  graphics_context_set_stroke_color(ctx, inks[FaceInkRing]);
   graphics_context_set_stroke_width(ctx, CLOCK_FACE_STROKE_WIDTH);
   #if defined(PBL_ROUND)
-    graphics_draw_circle(ctx, s_center, s_radius);
+    graphics_draw_circle(ctx, s_watchface.center, s_watchface.radius);
   #else
     GRect rect = GRect(
-      s_center.x - s_w_radius,
-      s_center.y - s_h_radius,
-      2 * s_w_radius,
-      2 * s_h_radius
+      s_watchface.center.x - FACE_W_RADIUS,
+      s_watchface.center.y - FACE_H_RADIUS,
+      2 * FACE_W_RADIUS,
+      2 * FACE_H_RADIUS
     );
     graphics_draw_round_rect(ctx, rect, SQR_WATCHFACE_RADIOUS);
   #endif
 }
 
+// Marker endpoints and label rects come from s_face_geometry (watchface.c)
 static void draw_marker(GContext *ctx, int index) {
-  int32_t angle    = degrees_to_trig_angle(index * 6);
-  bool    is_major = is_major_marker(index);
-  int     len      = is_major ? MAJOR_MARKER_LENGTH : MINOR_MARKER_LENGTH;
-
-  int face_w = get_face_w_edge();
-  int face_h = get_face_h_edge();
-
-  GPoint outer = get_point_on_face(angle, face_w, face_h);
-  GPoint inner = get_point_on_face(angle, face_w - len, face_h - len);
+  bool is_major = is_major_marker(index);
 
   graphics_context_set_stroke_width(ctx, is_major ? MAJOR_MARKER_WIDTH : MINOR_MARKER_WIDTH);
-  graphics_draw_line(ctx, outer, inner);
+  graphics_draw_line(ctx, s_face_geometry.marker_outer[index],
+                          s_face_geometry.marker_inner[index]);
 }
 
-static void draw_hour_number(GContext *ctx, int index) {
+static void draw_hour_number(GContext *ctx, int index, const GColor *inks) {
   if (!is_major_marker(index)) return;
 
-  int32_t angle  = degrees_to_trig_angle(index * 6);
-
-  int face_w  = get_face_w_edge();
-  int face_h  = get_face_h_edge();
-  int offset  = MAJOR_MARKER_LENGTH + s_num_offset;
-
-  GPoint pos  = get_point_on_face(angle, face_w - offset, face_h - offset);
-  int    hour = get_display_hour(index);
+  int hour = get_display_hour(index);
 
   static char buffer[3];
   snprintf(buffer, sizeof(buffer), "%d", hour);
@@ -74,36 +82,152 @@ static void draw_hour_number(GContext *ctx, int index) {
   bool is_active = (hour == s_active_hour);
   #if defined(PBL_COLOR)
   graphics_context_set_text_color(ctx,
-    is_active ? HOUR_NUMBER_ACTIVE_COLOR : HOUR_NUMBER_INACTIVE_COLOR
+    is_active ? inks[FaceInkLabelActive] : inks[FaceInkLabel]
   );
   #else
-  // B&W platforms: draw all numbers in white — no active-hour highlighting
+  // B&W platforms: draw all numbers in one color — no active-hour highlighting
   (void)is_active;
-  graphics_context_set_text_color(ctx, HOUR_NUMBER_ACTIVE_COLOR);
+  graphics_context_set_text_color(ctx, inks[FaceInkLabel]);
   #endif
 
-  GRect text_rect = GRect(pos.x - 16, pos.y - 16, 32, 32);
-  graphics_draw_text(ctx, buffer, s_font,
+  GRect text_rect = s_face_geometry.label_rect[index / MAJOR_MARKER_INTERVAL];
+  graphics_draw_text(ctx, buffer, s_watchface.hour_font,
                      text_rect, GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
 }
 
-static void draw_all_markers(GContext *ctx) {
-  graphics_context_set_stroke_color(ctx, GColorWhite);
+static void draw_all_markers(GContext *ctx, const GColor *inks) {
   for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+    graphics_context_set_stroke_color(ctx, inks[FaceInkRing]);
     draw_marker(ctx, i);
-    if (i % 5 == 0) draw_hour_number(ctx, i);
+    if (i % 5 == 0) draw_hour_number(ctx, i, inks);
+  }
+}
+
+static void draw_face(GContext *ctx, const GColor *inks) {
+  draw_clock_face(ctx, inks);
+  draw_all_markers(ctx, inks);
+}
+
+// The theme's colors in palette-slot order
+static void theme_inks(GColor *inks) {
+  const Theme *theme = theme_get();
+  inks[FaceInkBackground]  = GColorBlack;
+  inks[FaceInkRing]        = theme->ring;
+  inks[FaceInkLabel]       = theme->label;
+  inks[FaceInkLabelActive] = theme->label_active;
+}
+
+#if defined(PBL_COLOR)
+// Label rect of the 12-hour clock value hour (1..12) in face coordinates
+static GRect label_rect_for_hour(int hour) {
+  return s_face_geometry.label_rect[hour % 12];
+}
+
+// Rasterizes with the key colors and no antialiasing, converts the frame
+// buffer into palette indices, then blits the result so this frame shows the
+// themed colors rather than the keys
+static bool rasterize_face(Layer *layer, GContext *ctx) {
+  graphics_context_set_antialiased(ctx, false);
+  draw_face(ctx, FACE_KEYS);
+  graphics_context_set_antialiased(ctx, true);
+
+  GRect screen = bitmap_capture_screen_rect(layer, layer_get_bounds(layer));
+  bool  ok     = bitmap_capture_palettized(ctx, screen, s_face_bitmap, FACE_KEYS, FaceInkCount);
+  if (ok) {
+    graphics_draw_bitmap_in_rect(ctx, s_face_bitmap, layer_get_bounds(layer));
+  } else {
+    GColor inks[FaceInkCount];
+    theme_inks(inks);
+    draw_face(ctx, inks);
   }
+  return ok;
+}
+#else
+// The face layer is the bottom layer, so at this point the frame buffer
+// holds exactly the black background plus the face
+static bool rasterize_face(Layer *layer, GContext *ctx) {
+  GColor inks[FaceInkCount];
+  theme_inks(inks);
+  draw_face(ctx, inks);
+
+  GRect screen = bitmap_capture_screen_rect(layer, layer_get_bounds(layer));
+  return bitmap_capture_frame(ctx, screen, s_face_bitmap);
+}
+#endif
+
+// A capture that failed (e.g. the face pushed partly off screen by a peek)
+// fails the same way every frame, drawing the face twice each time, so it is
+// only retried once the layer sits somewhere else (the peek has gone)
+static bool capture_allowed(Layer *layer) {
+  GRect screen = bitmap_capture_screen_rect(layer, layer_get_bounds(layer));
+  if (s_capture_blocked && grect_equal(&screen, &s_blocked_rect)) return false;
+  s_capture_blocked = false;
+  s_blocked_rect    = screen;
+  return true;
 }
 
 // ============================================================================
-// LAYER UPDATE PROC — static, called once by Pebble at layer creation
+// LAYER UPDATE PROC — blits the cached face; rasterizes only when invalid
 // ============================================================================
 
 static void face_update_proc(Layer *layer, GContext *ctx) {
-  draw_clock_face(ctx);
-  draw_all_markers(ctx);
+  uint32_t start = profile_begin();
+
+  if (s_face_cached) {
+    graphics_draw_bitmap_in_rect(ctx, s_face_bitmap, layer_get_bounds(layer));
+  } else if (s_face_bitmap && s_face_warm && capture_allowed(layer)) {
+    s_face_cached     = rasterize_face(layer, ctx);
+    s_capture_blocked = !s_face_cached;
+  } else {
+    GColor inks[FaceInkCount];
+    theme_inks(inks);
+    draw_face(ctx, inks);
+  }
+
+  profile_end(ProfileLayerFace, start);
 }
 
+// Compositor pass — target covers the same area as the face layer
+void face_layer_composite(Layer *target, GContext *ctx) {
+  if (s_face_layer) face_update_proc(target, ctx);
+}
+
+// ============================================================================
+// RENDER SCHEDULER HOOK
+// ============================================================================
+
+static int display_hour(int tm_hour) {
+  int hour = tm_hour % 12;
+  return hour == 0 ? 12 : hour;
+}
+
+#if defined(PBL_COLOR)
+// Neither an hour change nor a theme change re-rasterizes a valid cache:
+// the highlight moves by remapping two label rects, a theme by rewriting
+// the palette the bitmap points at
+static bool face_refresh(struct tm *now, uint32_t changed) {
+  bool dirty = false;
+
+  if (changed & RenderDepTheme) {
+    theme_inks(s_face_palette);
+    dirty = true;
+  }
+
+  int hour = display_hour(now->tm_hour);
+  if (hour != s_active_hour) {
+    if (s_face_cached && s_active_hour > 0) {
+      bitmap_remap_index(s_face_bitmap, label_rect_for_hour(s_active_hour),
+                         FaceInkLabelActive, FaceInkLabel);
+      bitmap_remap_index(s_face_bitmap, label_rect_for_hour(hour),
+                         FaceInkLabel, FaceInkLabelActive);
+    }
+    s_active_hour = hour;
+    dirty = true;
+  }
+  return dirty;
+}
+#endif
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
@@ -112,19 +236,45 @@ Layer* face_layer_create(GRect bounds, Layer *parent) {
   s_face_layer = layer_create(bounds);
   layer_set_update_proc(s_face_layer, face_update_proc);
   layer_add_child(parent, s_face_layer);
+
+  // There is no GContext outside a render pass, so the bitmap is allocated
+  // here and filled by the first face_update_proc after face_layer_warm_cache. Color platforms (round
+  // included) cache 2-bit palettized; B&W caches the 1-bit frame buffer.
+  // If the allocation fails the layer just keeps drawing primitives.
+  #if FACE_CACHE_ENABLED
+  #if defined(PBL_COLOR)
+  theme_inks(s_face_palette);
+  s_face_bitmap = gbitmap_create_blank_with_palette(bounds.size, GBitmapFormat2BitPalette,
+                                                    s_face_palette, false);
+  #else
+  s_face_bitmap = gbitmap_create_blank(bounds.size, bitmap_capture_format());
+  #endif
+  #endif
+  s_face_cached = false;
+  s_active_hour = display_hour(watchface_localtime()->tm_hour);
+
+  // B&W platforms draw every number alike and have one theme, so the face
+  // never changes
+  #if defined(PBL_COLOR)
+  render_register(s_face_layer, RenderDepHour | RenderDepTheme, face_refresh);
+  #endif
   return s_face_layer;
 }
 
+void face_layer_warm_cache(void) {
+  if (s_face_warm) return;
+  s_face_warm = true;
+  if (s_face_bitmap) layer_mark_dirty(s_face_layer);
+}
+
 void face_layer_destroy(void) {
+  if (s_face_bitmap) {
+    gbitmap_destroy(s_face_bitmap);
+    s_face_bitmap = NULL;
+  }
+  s_face_cached = false;
+  s_face_warm   = false;
+  render_unregister(s_face_layer);
   layer_destroy(s_face_layer);
   s_face_layer = NULL;
 }
-
-bool face_layer_update_hour(int current_hour) {
-  int display_hour = current_hour % 12;
-  if (display_hour == 0) display_hour = 12;
-  if (display_hour == s_active_hour) return false;
-  s_active_hour = display_hour;
-  layer_mark_dirty(s_face_layer);
-  return true;
-}
\ No newline at end of file
@@ -3,11 +3,19 @@
 
 // Creates the static face layer (clock ring + markers + hour numbers)
 // Parent layer is the window root layer
-// This layer is drawn ONCE and never marked dirty again
+// The face is rasterized once into an offscreen bitmap and blitted on every
+// frame after that. On color platforms the bitmap is 2-bit palettized, so a
+// theme change or the hourly highlight move (via the render scheduler) only
+// rewrites palette entries or two label rects — never a full re-raster
 Layer* face_layer_create(GRect bounds, Layer *parent);
 
-// Destroys the face layer — call from main_window_unload
-void face_layer_destroy(void);
+// Lets the next frame fill the face cache. Until then the face is drawn from
+// primitives, so the first frame after launch skips the capture — main.c
+// calls this from a deferred startup stage
+void face_layer_warm_cache(void);
+
+// Draws the face into target, a layer covering the same area (compositor.h)
+void face_layer_composite(Layer *target, GContext *ctx);
 
-// Returns true if the face layer was marked dirty
-bool face_layer_update_hour(int current_hour);
\ No newline at end of file
+// Destroys the face layer — call from main_window_unload
+void face_layer_destroy(void);
\ No newline at end of file
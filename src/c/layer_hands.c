@@ -1,106 +1,259 @@
 #include "layer_hands.h"
 #include "watchface.h"
-#include "layer_face.h"
+#include "layer_seconds.h"
+#include "profile.h"
+#include "power_governor.h"
+#include "battery_policy.h"
+#include "render_scheduler.h"
+#include "theme.h"
+#include "bench.h"
+#include "startup.h"
+#include "second_tz.h"
 
 // ============================================================================
 // PRIVATE STATE
 // ============================================================================
 
 static Layer    *s_hands_layer;
-static bool      s_show_seconds = false;
 static AppTimer *s_seconds_timer = NULL;
 
+// Each renderer is only compiled in where it draws: the GPath outlines cost
+// two heap allocations, so the default line build does not create them.
+// The bench build has both, to time one against the other
+#if HANDS_USE_GPATH || defined(WATCHFACE_BENCH)
+static GPath    *s_hour_path;
+static GPath    *s_minute_path;
+static GPoint    s_hour_points[10];
+static GPoint    s_minute_points[5];
+#endif
+
 // ============================================================================
 // PRIVATE: SECONDS TIMER MANAGEMENT
 // ============================================================================
 
-// Called when the 10-second display window expires
+// Called when the shake-to-show display window expires
 static void seconds_timer_callback(void *context) {
   s_seconds_timer = NULL;
-  s_show_seconds  = false;
 
   // Stop per-second ticks — back to power-efficient minute ticks only
-  tick_timer_service_subscribe(MINUTE_UNIT, (TickHandler)context);
+  if (seconds_layer_needs_ticks()) power_governor_set_seconds(false);
 
-  layer_mark_dirty(s_hands_layer);
+  seconds_layer_set_visible(false);
 }
 
 // ============================================================================
 // PRIVATE DRAWING FUNCTIONS
 // ============================================================================
 
-static void draw_date_widget(GContext *ctx, struct tm *t) {
-  static const char * const WEEKDAYS[] = {
-    "SUN","MON","TUE","WED","THU","FRI","SAT"
-  };
-  static char date_buffer[8]; // "SAT-31\0"
-  snprintf(date_buffer, sizeof(date_buffer), "%s-%d", WEEKDAYS[t->tm_wday], t->tm_mday);
-
-  // Center vertically between the center dot (bottom) and the "6" hour label (top)
-  int face_h_edge = s_h_radius - (CLOCK_FACE_STROKE_WIDTH / 2);
-  int num_offset  = MAJOR_MARKER_LENGTH + s_num_offset;
-  int six_top     = s_center.y + (face_h_edge - num_offset) - 16;
-  int dot_bottom  = s_center.y + CENTER_DOT_RADIUS;
-  int mid_y       = (dot_bottom + six_top) / 2;
-
-  GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD);
-  graphics_context_set_text_color(ctx, PBL_IF_COLOR_ELSE(WATCHFACE_THEME_COLOR, GColorWhite));
-  GRect text_rect = GRect(s_center.x - 40, mid_y - 12, 80, 24);
-  graphics_draw_text(ctx, date_buffer, font,
-                     text_rect, GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
+// Shared with layer_seconds.c, which redraws the dot above the second hand.
+// The GPath look uses two fills instead of a thick stroked circle: the black
+// disc clears the hands around the pivot, the theme-colored disc sits inside
+// it. The line renderer keeps the original stroked ring
+void hands_draw_center_dot(GContext *ctx, GPoint center) {
+  if (HANDS_USE_GPATH) {
+    graphics_context_set_fill_color(ctx, GColorBlack);
+    graphics_fill_circle(ctx, center, CENTER_DOT_RADIUS + MINUTE_HAND_WIDTH / 2);
+  } else {
+    graphics_context_set_stroke_width(ctx, MINUTE_HAND_WIDTH);
+    graphics_context_set_stroke_color(ctx, GColorBlack);
+    graphics_draw_circle(ctx, center, CENTER_DOT_RADIUS);
+  }
+  graphics_context_set_fill_color(ctx, theme_get()->accent);
+  graphics_fill_circle(ctx, center, CENTER_DOT_RADIUS - 2);
 }
 
-static void draw_clock_hands(GContext *ctx, struct tm *t) {
+#if !HANDS_USE_GPATH || defined(WATCHFACE_BENCH)
+// Line renderer — endpoints come from s_hands_geometry (watchface.c), the
+// hour hand is hollowed by a second black pass
+static void draw_clock_hands_lines(GContext *ctx, int h_index, int minute) {
   static uint8_t hour_thickness = HOUR_HAND_WIDTH / 2;
-  int32_t h_angle = degrees_to_trig_angle((t->tm_hour % 12) * 30 + (t->tm_min / 2));
-  int32_t m_angle = degrees_to_trig_angle(t->tm_min * 6);
-  GPoint  h_end   = get_point_on_circle(h_angle, s_radius * HOUR_HAND_LENGTH_RATIO);
-  GPoint  m_end   = get_point_on_circle(m_angle, s_radius * MINUTE_HAND_LENGTH_RATIO);
-  GPoint  h_short = get_point_on_circle(h_angle, s_radius * HOUR_HAND_LENGTH_RATIO - hour_thickness + 1);
+  GPoint h_end   = s_hands_geometry.hour_end[h_index];
+  GPoint m_end   = s_hands_geometry.minute_end[minute];
+  GPoint h_short = s_hands_geometry.hour_inner[h_index];
 
   // Draw hour hand in two passes
   graphics_context_set_stroke_color(ctx, GColorWhite);
   graphics_context_set_stroke_width(ctx, HOUR_HAND_WIDTH);
-  graphics_draw_line(ctx, s_center, h_end);
+  graphics_draw_line(ctx, s_watchface.center, h_end);
 
   graphics_context_set_stroke_color(ctx, GColorBlack);
   graphics_context_set_stroke_width(ctx, HOUR_HAND_WIDTH - hour_thickness);
-  graphics_draw_line(ctx, s_center, h_short);
+  graphics_draw_line(ctx, s_watchface.center, h_short);
 
   // Draw minute hand
   graphics_context_set_stroke_color(ctx, GColorWhite);
   graphics_context_set_stroke_width(ctx, MINUTE_HAND_WIDTH);
-  graphics_draw_line(ctx, s_center, m_end);
-
-  // Draw seconds hand only when s_show_seconds is active
-  if (s_show_seconds) {
-    int32_t s_angle = degrees_to_trig_angle(t->tm_sec * 6);
-    GPoint  s_end   = get_point_on_circle(s_angle, s_radius * SECOND_HAND_LENGTH_RATIO);
-    GPoint s_start = get_point_on_circle(revert_angle(s_angle), s_radius * 0.2);
-    graphics_context_set_stroke_color(ctx, WATCHFACE_THEME_COLOR);
-    graphics_context_set_stroke_width(ctx, SECOND_HAND_WIDTH);
-    graphics_draw_line(ctx, s_start, s_end);
+  graphics_draw_line(ctx, s_watchface.center, m_end);
+}
+#endif
+
+#if HANDS_USE_GPATH || defined(WATCHFACE_BENCH)
+// Path renderer — one fill per hand. The hour hand outline already has the
+// slot cut out, so no pixel is drawn twice
+static void draw_clock_hands_paths(GContext *ctx, int h_index, int minute) {
+  graphics_context_set_fill_color(ctx, GColorWhite);
+
+  gpath_rotate_to(s_hour_path, TRIG_MAX_ANGLE * h_index / HOUR_HAND_POSITIONS);
+  gpath_draw_filled(ctx, s_hour_path);
+
+  gpath_rotate_to(s_minute_path, TRIG_MAX_ANGLE * minute / MINUTE_MARKER_COUNT);
+  gpath_draw_filled(ctx, s_minute_path);
+}
+#endif
+
+// Hand for the second time zone, under the main hands. It reads against the
+// 12-hour dial in whole degrees, so it reuses the hour hand's endpoint
+// table; the tip is a ring before noon there and a dot after it
+static void draw_gmt_hand(GContext *ctx, int degrees, bool pm) {
+  GColor accent = theme_get()->accent;
+  GPoint tip    = s_hands_geometry.hour_end[degrees];
+
+  graphics_context_set_stroke_color(ctx, accent);
+  graphics_context_set_stroke_width(ctx, GMT_HAND_WIDTH);
+  graphics_draw_line(ctx, s_watchface.center, tip);
+
+  if (pm) {
+    graphics_context_set_fill_color(ctx, accent);
+    graphics_fill_circle(ctx, tip, GMT_TIP_RADIUS);
+  } else {
+    graphics_context_set_fill_color(ctx, GColorBlack);
+    graphics_fill_circle(ctx, tip, GMT_TIP_RADIUS);
+    graphics_context_set_stroke_width(ctx, 1);
+    graphics_draw_circle(ctx, tip, GMT_TIP_RADIUS);
   }
+}
+
+static void draw_clock_hands(GContext *ctx, struct tm *t) {
+  int h_index = (t->tm_hour % 12) * 30 + (t->tm_min / 2);
+  int minute  = power_governor_display_minute(t->tm_min);
+
+  int gmt = second_tz_degrees();
+  if (gmt >= 0) draw_gmt_hand(ctx, gmt, second_tz_is_pm());
+
+  #if HANDS_USE_GPATH
+  draw_clock_hands_paths(ctx, h_index, minute);
+  #else
+  draw_clock_hands_lines(ctx, h_index, minute);
+  #endif
 
   // Center dot drawn last so it sits on top of all hands
-  graphics_context_set_stroke_width(ctx, MINUTE_HAND_WIDTH);
-  graphics_context_set_stroke_color(ctx, GColorBlack);
-  graphics_draw_circle(ctx, s_center, CENTER_DOT_RADIUS);
-  graphics_context_set_fill_color(ctx, WATCHFACE_THEME_COLOR);
-  graphics_fill_circle(ctx, s_center, CENTER_DOT_RADIUS - 2);
+  hands_draw_center_dot(ctx, s_watchface.center);
+}
+
+#if HANDS_USE_GPATH || defined(WATCHFACE_BENCH)
+// ============================================================================
+// PRIVATE: HAND OUTLINES
+// ============================================================================
+
+// Both outlines point at 12 o'clock around the pivot (0,0). The squared-off
+// tails stop at the pivot, under the center dot; the tips are chamfered in
+// place of the round caps the line renderer draws
+static void build_hand_paths(void) {
+  int hour_len   = s_watchface.radius * HOUR_HAND_LENGTH_PCT / 100;
+  int minute_len = s_watchface.radius * MINUTE_HAND_LENGTH_PCT / 100;
+  int w_out      = HOUR_HAND_WIDTH / 2;
+  int w_slot     = (HOUR_HAND_WIDTH - HOUR_HAND_WIDTH / 2) / 2;
+  int chamfer    = w_out / 2;
+  int slot_len   = hour_len - w_out + 1 + w_slot;  // matches hour_inner + cap
+  int w_min      = MINUTE_HAND_WIDTH / 2;
+
+  // U-shaped outline: outer edge up and over the tip, then back down the slot
+  GPoint *h = s_hour_points;
+  h[0] = GPoint(-w_out,            0);
+  h[1] = GPoint(-w_out,            -hour_len);
+  h[2] = GPoint(-chamfer,          -hour_len - chamfer);
+  h[3] = GPoint( chamfer,          -hour_len - chamfer);
+  h[4] = GPoint( w_out,            -hour_len);
+  h[5] = GPoint( w_out,            0);
+  h[6] = GPoint( w_slot,           0);
+  h[7] = GPoint( w_slot,           -slot_len);
+  h[8] = GPoint(-w_slot,           -slot_len);
+  h[9] = GPoint(-w_slot,           0);
+
+  GPoint *m = s_minute_points;
+  m[0] = GPoint(-w_min, 0);
+  m[1] = GPoint(-w_min, -minute_len);
+  m[2] = GPoint( 0,     -minute_len - w_min);
+  m[3] = GPoint( w_min, -minute_len);
+  m[4] = GPoint( w_min, 0);
+
+  // gpath_create keeps a pointer to the points, so they live in statics
+  s_hour_path   = gpath_create(&(GPathInfo) { ARRAY_LENGTH(s_hour_points),   s_hour_points });
+  s_minute_path = gpath_create(&(GPathInfo) { ARRAY_LENGTH(s_minute_points), s_minute_points });
+  gpath_move_to(s_hour_path,   s_watchface.center);
+  gpath_move_to(s_minute_path, s_watchface.center);
+}
+#endif
+
+#if defined(WATCHFACE_BENCH)
+// ============================================================================
+// PRIVATE: RENDERER BENCHMARK — both renderers over every hour position
+// ============================================================================
+
+static void bench_repaint(void *context) {
+  layer_mark_dirty(window_get_root_layer(layer_get_window(s_hands_layer)));
+}
+
+// Runs inside the first frame; the test strokes are painted over right after
+static void bench_hand_renderers(GContext *ctx) {
+  static char res[16];  // "-32768x-32768"
+  GRect bounds = layer_get_bounds(s_hands_layer);
+  snprintf(res, sizeof(res), "%dx%d", bounds.size.w, bounds.size.h);
+  uint32_t start;
+
+  start = bench_now_ms();
+  for (int d = 0; d < HOUR_HAND_POSITIONS; d++) {
+    draw_clock_hands_lines(ctx, d, d % MINUTE_MARKER_COUNT);
+  }
+  bench_report("hands lines", res, bench_now_ms() - start, HOUR_HAND_POSITIONS);
+
+  start = bench_now_ms();
+  for (int d = 0; d < HOUR_HAND_POSITIONS; d++) {
+    draw_clock_hands_paths(ctx, d, d % MINUTE_MARKER_COUNT);
+  }
+  bench_report("hands gpath", res, bench_now_ms() - start, HOUR_HAND_POSITIONS);
+
+  app_timer_register(0, bench_repaint, NULL);
 }
+#endif
 
 // ============================================================================
 // LAYER UPDATE PROC
 // ============================================================================
 
 static void hands_update_proc(Layer *layer, GContext *ctx) {
-  time_t    now = time(NULL);
-  struct tm *t  = localtime(&now);
+  uint32_t  start = profile_begin();
+  struct tm *t  = watchface_localtime();
+
+  #if defined(WATCHFACE_BENCH)
+  static bool s_benched = false;
+  if (!s_benched) {
+    s_benched = true;
+    bench_hand_renderers(ctx);
+  }
+  #endif
 
-  face_layer_update_hour(t->tm_hour);
-  draw_date_widget(ctx, t);
   draw_clock_hands(ctx, t);
+
+  profile_end(ProfileLayerHands, start);
+  startup_frame_drawn();
+}
+
+// Compositor pass — target covers the same area as the hands layer
+void hands_layer_composite(Layer *target, GContext *ctx) {
+  if (s_hands_layer) hands_update_proc(target, ctx);
+}
+
+// ============================================================================
+// RENDER SCHEDULER HOOK
+// ============================================================================
+
+// In low power the hands only move every POWER_LOW_REDRAW_MINUTES; a cadence
+// change always redraws so the snapped minute hand catches up, a theme
+// change recolors the center dot, and a second-zone change moves the GMT hand
+static bool hands_refresh(struct tm *now, uint32_t changed) {
+  if (changed & (RenderDepPower | RenderDepTheme | RenderDepSecondTz)) return true;
+  return power_governor_should_redraw(now);
 }
 
 // ============================================================================
@@ -111,45 +264,58 @@ Layer* hands_layer_create(GRect bounds, Layer *parent) {
   s_hands_layer = layer_create(bounds);
   layer_set_update_proc(s_hands_layer, hands_update_proc);
   layer_add_child(parent, s_hands_layer);
+  #if HANDS_USE_GPATH || defined(WATCHFACE_BENCH)
+  build_hand_paths();
+  #endif
+  render_register(s_hands_layer,
+                  RenderDepMinute | RenderDepPower | RenderDepTheme | RenderDepSecondTz,
+                  hands_refresh);
   return s_hands_layer;
 }
 
-void hands_layer_mark_dirty(void) {
-  layer_mark_dirty(s_hands_layer);
-}
-
 void hands_layer_destroy(void) {
   // Cancel any active timer before destroying the layer
   if (s_seconds_timer) {
     app_timer_cancel(s_seconds_timer);
     s_seconds_timer = NULL;
   }
+  #if HANDS_USE_GPATH || defined(WATCHFACE_BENCH)
+  gpath_destroy(s_hour_path);
+  gpath_destroy(s_minute_path);
+  #endif
+  render_unregister(s_hands_layer);
   layer_destroy(s_hands_layer);
   s_hands_layer = NULL;
 }
 
 // Tap handler — registered in main.c via accel_tap_service_subscribe
 void hands_layer_handle_tap(AccelAxisType axis, int32_t direction) {
+  profile_trigger(ProfileTriggerTap);
+  power_governor_wake();
+
+  // Shortened on low battery, 0 (no seconds at all) when critical
+  uint32_t duration = battery_policy_seconds_duration();
+
   // If seconds are already showing, reset the countdown timer
   if (s_seconds_timer) {
-    app_timer_reschedule(s_seconds_timer, SECONDS_DISPLAY_DURATION);
+    if (duration) app_timer_reschedule(s_seconds_timer, duration);
     return;
   }
 
+  // Counted once per display the shake would have started, not per tap
+  battery_policy_skipped_seconds(SECONDS_DISPLAY_DURATION - duration);
+  if (duration == 0) return;
+
   // First shake — activate seconds display
-  s_show_seconds = true;
+  seconds_layer_set_visible(true);
 
   // Switch from MINUTE_UNIT to SECOND_UNIT while seconds are visible
-  // Pass the tick_handler from main.c via context so we can restore it
-  extern void tick_handler(struct tm*, TimeUnits);
-  tick_timer_service_subscribe(SECOND_UNIT, tick_handler);
+  if (seconds_layer_needs_ticks()) power_governor_set_seconds(true);
 
-  // Schedule auto-hide after SECONDS_DISPLAY_DURATION milliseconds
+  // Schedule auto-hide after duration milliseconds
   s_seconds_timer = app_timer_register(
-    SECONDS_DISPLAY_DURATION,
+    duration,
     seconds_timer_callback,
-    (void*)tick_handler   // pass tick_handler so callback can restore it
+    NULL
   );
-
-  layer_mark_dirty(s_hands_layer);
 }
\ No newline at end of file
@@ -1,15 +1,19 @@
 #pragma once
 #include <pebble.h>
 
-// Creates the dynamic hands layer (hour + minute hands + date widget)
-// Sits on top of the face layer — redrawn every minute tick
+// Creates the dynamic hands layer (hour + minute hands)
+// Sits on top of the face layer — redrawn by the render scheduler every
+// minute tick
 Layer* hands_layer_create(GRect bounds, Layer *parent);
 
-// Call from tick_handler to refresh hands and date
-void hands_layer_mark_dirty(void);
+// Draws the hands into target, a layer covering the same area (compositor.h)
+void hands_layer_composite(Layer *target, GContext *ctx);
 
 // Destroys the hands layer — call from main_window_unload
 void hands_layer_destroy(void);
 
+// Draws the center dot at center (layer coordinates) — shared with the seconds layer
+void hands_draw_center_dot(GContext *ctx, GPoint center);
+
 // Shake to show feature
 void   hands_layer_handle_tap(AccelAxisType axis, int32_t direction);
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "layer_seconds.h"
+#include "layer_hands.h"
+#include "watchface.h"
+#include "profile.h"
+#include "render_scheduler.h"
+#include "theme.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static Layer *s_seconds_layer;
+static GPoint s_start;  // hand endpoints in window coordinates
+static GPoint s_end;
+
+#if defined(WATCHFACE_SMOOTH_SECONDS)
+static AppTimer *s_sweep_timer    = NULL;
+static uint32_t  s_frame_interval = SWEEP_FRAME_MIN_MS;
+#endif
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+// Bounding box of the hand segment plus the center dot redrawn on top of it
+static GRect get_hand_frame(GPoint start, GPoint end) {
+  int pad     = SECOND_HAND_WIDTH;
+  int dot_pad = CENTER_DOT_RADIUS + MINUTE_HAND_WIDTH / 2 + 1;
+
+  int x0 = (start.x < end.x ? start.x : end.x) - pad;
+  int y0 = (start.y < end.y ? start.y : end.y) - pad;
+  int x1 = (start.x > end.x ? start.x : end.x) + pad;
+  int y1 = (start.y > end.y ? start.y : end.y) + pad;
+
+  if (s_watchface.center.x - dot_pad < x0) x0 = s_watchface.center.x - dot_pad;
+  if (s_watchface.center.y - dot_pad < y0) y0 = s_watchface.center.y - dot_pad;
+  if (s_watchface.center.x + dot_pad > x1) x1 = s_watchface.center.x + dot_pad;
+  if (s_watchface.center.y + dot_pad > y1) y1 = s_watchface.center.y + dot_pad;
+
+  return GRect(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+}
+
+static GPoint to_local(GPoint p, GPoint origin) {
+  return GPoint(p.x - origin.x, p.y - origin.y);
+}
+
+// Moving the frame keeps the layer's clip to the hand's box, but the
+// firmware still repaints the whole window for the frame; a position that
+// has not changed costs no frame at all
+static void move_hand(GPoint start, GPoint end) {
+  if (gpoint_equal(&start, &s_start) && gpoint_equal(&end, &s_end)) return;
+  s_start = start;
+  s_end   = end;
+  layer_set_frame(s_seconds_layer, get_hand_frame(s_start, s_end));
+  layer_mark_dirty(s_seconds_layer);
+}
+
+#if defined(WATCHFACE_SMOOTH_SECONDS)
+// ============================================================================
+// PRIVATE: SMOOTH SWEEP LOOP
+// ============================================================================
+
+// Halve the frame rate as soon as a frame eats more than its budget; win it
+// back a quarter at a time once frames are comfortably under it. The whole
+// frame counts (every layer the sweep's dirty region repaints, and the
+// traversal between them), not just the second hand's own draw
+static void adapt_frame_interval(void) {
+  uint32_t frame_ms = profile_frame_ms();
+  uint32_t budget   = s_frame_interval * SWEEP_RENDER_BUDGET_PCT / 100;
+  if (frame_ms > budget) {
+    s_frame_interval *= 2;
+    if (s_frame_interval > SWEEP_FRAME_MAX_MS) s_frame_interval = SWEEP_FRAME_MAX_MS;
+  } else if (frame_ms * 2 < budget) {
+    s_frame_interval -= s_frame_interval / 4;
+    if (s_frame_interval < SWEEP_FRAME_MIN_MS) s_frame_interval = SWEEP_FRAME_MIN_MS;
+  }
+}
+
+// Positions the hand from the millisecond phase within the current minute,
+// then schedules the next frame
+static void sweep_step(void *context) {
+  time_t   s;
+  uint16_t ms;
+  time_ms(&s, &ms);
+  uint32_t phase = (uint32_t)(s % 60) * 1000 + ms;
+  int      pos   = phase * SWEEP_HAND_POSITIONS / 60000;
+  move_hand(s_hands_geometry.sweep_start[pos], s_hands_geometry.sweep_end[pos]);
+
+  adapt_frame_interval();
+  s_sweep_timer = app_timer_register(s_frame_interval, sweep_step, NULL);
+}
+
+static void sweep_stop(void) {
+  if (s_sweep_timer) {
+    app_timer_cancel(s_sweep_timer);
+    s_sweep_timer = NULL;
+  }
+}
+#endif
+
+// ============================================================================
+// LAYER UPDATE PROC
+// ============================================================================
+
+// origin is where the context's (0,0) sits in window coordinates
+static void draw_second_hand(GContext *ctx, GPoint origin) {
+  uint32_t start = profile_begin();
+
+  graphics_context_set_stroke_color(ctx, theme_get()->accent);
+  graphics_context_set_stroke_width(ctx, SECOND_HAND_WIDTH);
+  graphics_draw_line(ctx, to_local(s_start, origin), to_local(s_end, origin));
+
+  // Center dot drawn last so it sits on top of the second hand too
+  hands_draw_center_dot(ctx, to_local(s_watchface.center, origin));
+
+  profile_end(ProfileLayerSeconds, start);
+}
+
+static void seconds_update_proc(Layer *layer, GContext *ctx) {
+  draw_second_hand(ctx, layer_get_frame(layer).origin);
+}
+
+// Compositor pass — target is in window coordinates, so no shift
+void seconds_layer_composite(Layer *target, GContext *ctx) {
+  if (!s_seconds_layer || layer_get_hidden(s_seconds_layer)) return;
+  draw_second_hand(ctx, GPointZero);
+}
+
+// ============================================================================
+// RENDER SCHEDULER HOOK
+// ============================================================================
+
+#if !defined(WATCHFACE_SMOOTH_SECONDS)
+// Tick mode only — the sweep loop moves the hand on its own timer
+static void place_tick_hand(int tm_sec) {
+  // tm_sec can be 60 on a leap second
+  int sec = tm_sec % MINUTE_MARKER_COUNT;
+  move_hand(s_hands_geometry.second_start[sec], s_hands_geometry.second_end[sec]);
+}
+
+static bool seconds_refresh(struct tm *now, uint32_t changed) {
+  if (layer_get_hidden(s_seconds_layer)) return false;
+  place_tick_hand(now->tm_sec);
+  return true;
+}
+#endif
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+Layer* seconds_layer_create(GRect bounds, Layer *parent) {
+  s_seconds_layer = layer_create(bounds);
+  layer_set_update_proc(s_seconds_layer, seconds_update_proc);
+  layer_set_hidden(s_seconds_layer, true);
+  layer_add_child(parent, s_seconds_layer);
+  #if !defined(WATCHFACE_SMOOTH_SECONDS)
+  render_register(s_seconds_layer, RenderDepSecond | RenderDepTap | RenderDepTheme, seconds_refresh);
+  #endif
+  return s_seconds_layer;
+}
+
+// The hand is placed before the layer is shown, so no frame between now and
+// the next flush or sweep step can draw it where it was last hidden
+void seconds_layer_set_visible(bool visible) {
+  #if defined(WATCHFACE_SMOOTH_SECONDS)
+  sweep_stop();
+  if (visible) {
+    s_frame_interval = SWEEP_FRAME_MIN_MS;
+    sweep_step(NULL);
+  }
+  #else
+  if (visible) place_tick_hand(watchface_localtime()->tm_sec);
+  render_invalidate(RenderDepTap);
+  #endif
+  layer_set_hidden(s_seconds_layer, !visible);
+}
+
+bool seconds_layer_needs_ticks(void) {
+  #if defined(WATCHFACE_SMOOTH_SECONDS)
+  return false;
+  #else
+  return true;
+  #endif
+}
+
+void seconds_layer_destroy(void) {
+  #if defined(WATCHFACE_SMOOTH_SECONDS)
+  sweep_stop();
+  #endif
+  if (s_seconds_layer) {
+    render_unregister(s_seconds_layer);
+    layer_destroy(s_seconds_layer);
+    s_seconds_layer = NULL;
+  }
+}
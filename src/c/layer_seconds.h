@@ -0,0 +1,27 @@
+#pragma once
+#include <pebble.h>
+
+// Smooth-sweep frame pacing (WATCHFACE_SMOOTH_SECONDS=1 only)
+#define SWEEP_FRAME_MIN_MS        66   // ~15 fps ceiling
+#define SWEEP_FRAME_MAX_MS        250  // 4 fps floor when frames run long
+#define SWEEP_RENDER_BUDGET_PCT   50   // share of the frame interval a full frame may use
+
+// Creates the seconds-hand layer — hidden until shake-to-show activates it.
+// Sits on top of the hands layer. Its frame is shrunk to the bounding box of
+// the current second hand, so a per-second tick only repaints that region.
+Layer* seconds_layer_create(GRect bounds, Layer *parent);
+
+// Shows or hides the second hand. While visible, the render scheduler moves
+// it on every SECOND_UNIT tick — or, built with WATCHFACE_SMOOTH_SECONDS=1,
+// an AppTimer loop sweeps it from the time_ms phase. Hiding stops the loop
+void seconds_layer_set_visible(bool visible);
+
+// False when the sweep loop drives the hand, so no SECOND_UNIT ticks are needed
+bool seconds_layer_needs_ticks(void);
+
+// Draws the visible second hand into target, a layer in window coordinates
+// (compositor.h)
+void seconds_layer_composite(Layer *target, GContext *ctx);
+
+// Destroys the seconds layer — call from main_window_unload
+void seconds_layer_destroy(void);
@@ -1,5 +1,17 @@
 #include "layer_weather.h"
 #include "watchface.h"
+#include "profile.h"
+#include "bitmap_capture.h"
+#include "render_scheduler.h"
+#include "theme.h"
+#include "sparkline.h"
+#include "battery_policy.h"
+
+// ============================================================================
+// PRIVATE CONSTANTS
+// ============================================================================
+
+#define PERSIST_KEY_WEATHER  1
 
 // ============================================================================
 // PRIVATE STATE
@@ -9,6 +21,10 @@ static Layer         *s_weather_layer;
 static int            s_temp_c    = 0;
 static WeatherIconType s_icon     = WeatherIconUnknown;
 static bool           s_has_data  = false;
+static time_t         s_updated_at = 0;  // when s_temp_c/s_icon were received
+
+// One offscreen bitmap per drawable icon, rasterized the first time it shows
+static GBitmap       *s_icon_cache[WeatherIconUnknown];
 
 // ============================================================================
 // ICON DRAWING — all primitives, no resources
@@ -26,23 +42,23 @@ static void draw_icon_clear(GContext *ctx, GPoint origin) {
   // Sun: filled circle + 8 short rays
   int cx = origin.x + 10;
   int cy = origin.y + 10;
-  // Rays
-  graphics_context_set_stroke_color(ctx, WATCHFACE_THEME_COLOR);
+  // Rays — kept within radius 9 so they fit the ICON_W x ICON_H cache cell
+  graphics_context_set_stroke_color(ctx, theme_get()->accent);
   graphics_context_set_stroke_width(ctx, 1);
   for (int d = 0; d < 360; d += 45) {
     int32_t angle = degrees_to_trig_angle(d);
     GPoint inner = {
-      .x = cx + (int)(sin_lookup(angle) * 8 / TRIG_MAX_RATIO),
-      .y = cy - (int)(cos_lookup(angle) * 8 / TRIG_MAX_RATIO)
+      .x = cx + (int)(sin_lookup(angle) * 7 / TRIG_MAX_RATIO),
+      .y = cy - (int)(cos_lookup(angle) * 7 / TRIG_MAX_RATIO)
     };
     GPoint outer = {
-      .x = cx + (int)(sin_lookup(angle) * 11 / TRIG_MAX_RATIO),
-      .y = cy - (int)(cos_lookup(angle) * 11 / TRIG_MAX_RATIO)
+      .x = cx + (int)(sin_lookup(angle) * 9 / TRIG_MAX_RATIO),
+      .y = cy - (int)(cos_lookup(angle) * 9 / TRIG_MAX_RATIO)
     };
     graphics_draw_line(ctx, inner, outer);
   }
   // Core
-  graphics_context_set_fill_color(ctx, WATCHFACE_THEME_COLOR);
+  graphics_context_set_fill_color(ctx, theme_get()->accent);
   graphics_fill_circle(ctx, GPoint(cx, cy), 5);
 }
 
@@ -97,12 +113,12 @@ static void draw_icon_snow(GContext *ctx, GPoint origin) {
   for (int d = 0; d < 180; d += 60) {
     int32_t angle = degrees_to_trig_angle(d);
     GPoint a = {
-      .x = cx + (int)(sin_lookup(angle) * 8 / TRIG_MAX_RATIO),
-      .y = cy - (int)(cos_lookup(angle) * 8 / TRIG_MAX_RATIO)
+      .x = cx + (int)(sin_lookup(angle) * 7 / TRIG_MAX_RATIO),
+      .y = cy - (int)(cos_lookup(angle) * 7 / TRIG_MAX_RATIO)
     };
     GPoint b = {
-      .x = cx - (int)(sin_lookup(angle) * 8 / TRIG_MAX_RATIO),
-      .y = cy + (int)(cos_lookup(angle) * 8 / TRIG_MAX_RATIO)
+      .x = cx - (int)(sin_lookup(angle) * 7 / TRIG_MAX_RATIO),
+      .y = cy + (int)(cos_lookup(angle) * 7 / TRIG_MAX_RATIO)
     };
     graphics_draw_line(ctx, a, b);
   }
@@ -139,60 +155,209 @@ static const IconDrawFn s_icon_fns[] = {
 };
 
 // ============================================================================
-// LAYER UPDATE PROC
+// PRIVATE: ICON CACHE — each icon drawn from primitives once, then blitted
 // ============================================================================
 
-static void weather_update_proc(Layer *layer, GContext *ctx) {
-  GRect bounds = layer_get_bounds(layer);
-  int w  = bounds.size.w;
-  int lh = bounds.size.h;
-
-  const int ICON_W = 20;
-  const int ICON_H = 20;
-  const int GAP    = 4;
-  const int TEXT_H = 26;
-  const int MAX_TEXT_W = 56; // enough for "-99°C"
-
-  // Build text first so we can measure it
-  static char temp_buf[8];
+#define ICON_W      20
+#define ICON_H      20
+
+#if defined(PBL_PLATFORM_APLITE)
+// Heap to keep free on aplite before holding on to more icon bitmaps
+#define ICON_CACHE_MIN_FREE  1536
+#endif
+
+static void free_icon_cache(WeatherIconType keep) {
+  for (int i = 0; i < WeatherIconUnknown; i++) {
+    if (i != (int)keep && s_icon_cache[i]) {
+      gbitmap_destroy(s_icon_cache[i]);
+      s_icon_cache[i] = NULL;
+    }
+  }
+}
+
+// Draws the icon's primitives on a clean black square and copies the result
+// into a new bitmap, then restores whatever was under the square so hands
+// passing behind the widget don't end up in the cache.
+// Returns NULL if there is no memory for it; the caller then draws primitives.
+static GBitmap* rasterize_icon(GContext *ctx, Layer *layer, WeatherIconType icon, GRect icon_rect) {
+  #if defined(PBL_PLATFORM_APLITE)
+  if (heap_bytes_free() < ICON_CACHE_MIN_FREE) free_icon_cache(icon);
+  if (heap_bytes_free() < ICON_CACHE_MIN_FREE) return NULL;
+  #endif
+
+  GBitmap *bitmap = gbitmap_create_blank(icon_rect.size, bitmap_capture_format());
+  GBitmap *saved  = gbitmap_create_blank(icon_rect.size, bitmap_capture_format());
+  GRect    screen = bitmap_capture_screen_rect(layer, icon_rect);
+
+  bool ok = bitmap && saved && bitmap_capture_frame(ctx, screen, saved);
+  if (ok) {
+    graphics_context_set_fill_color(ctx, GColorBlack);
+    graphics_fill_rect(ctx, icon_rect, 0, GCornerNone);
+    s_icon_fns[icon](ctx, icon_rect.origin);
+    ok = bitmap_capture_frame(ctx, screen, bitmap);
+    graphics_draw_bitmap_in_rect(ctx, saved, icon_rect);
+  }
+
+  if (saved) gbitmap_destroy(saved);
+  if (!ok) {
+    if (bitmap) gbitmap_destroy(bitmap);
+    return NULL;
+  }
+
+  #if defined(PBL_COLOR)
+  bitmap_make_transparent(bitmap, GColorBlack);
+  #endif
+  s_icon_cache[icon] = bitmap;
+  return bitmap;
+}
+
+// On low battery only a cached icon is drawn; one that isn't cached yet is
+// left out rather than rasterized or drawn from primitives
+static void draw_icon(GContext *ctx, Layer *layer, WeatherIconType icon, GPoint origin) {
+  GRect    icon_rect = GRect(origin.x, origin.y, ICON_W, ICON_H);
+  GBitmap *bitmap    = s_icon_cache[icon];
+  if (!bitmap && battery_policy_icon_cache_only()) {
+    battery_policy_skipped_icon();
+    return;
+  }
+  if (!bitmap) bitmap = rasterize_icon(ctx, layer, icon, icon_rect);
+
+  if (!bitmap) {
+    s_icon_fns[icon](ctx, origin);
+    return;
+  }
+
+  // Color: black was keyed out, so skip transparent pixels.
+  // B&W: OR in the white pixels only.
+  graphics_context_set_compositing_mode(ctx, PBL_IF_COLOR_ELSE(GCompOpSet, GCompOpOr));
+  graphics_draw_bitmap_in_rect(ctx, bitmap, icon_rect);
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+}
+
+// ============================================================================
+// PRIVATE: PERSISTENCE — last reading survives relaunches
+// ============================================================================
+
+typedef struct {
+  int32_t temp_c;
+  int32_t icon;
+  int32_t updated_at;
+} StoredWeather;
+
+static void save_weather(void) {
+  StoredWeather stored = {
+    .temp_c     = s_temp_c,
+    .icon       = s_icon,
+    .updated_at = (int32_t)s_updated_at,
+  };
+  persist_write_data(PERSIST_KEY_WEATHER, &stored, sizeof(stored));
+}
+
+// Restores the last reading unless it is too old to be worth showing
+static void load_weather(void) {
+  StoredWeather stored;
+  if (persist_read_data(PERSIST_KEY_WEATHER, &stored, sizeof(stored)) != (int)sizeof(stored)) {
+    return;
+  }
+  if (time(NULL) - stored.updated_at > WEATHER_MAX_AGE_S) return;
+
+  s_temp_c     = stored.temp_c;
+  s_icon       = (WeatherIconType)stored.icon;
+  s_updated_at = stored.updated_at;
+  s_has_data   = true;
+}
+
+// ============================================================================
+// PRIVATE: LAYOUT CACHE — rebuilt only when the data changes
+// ============================================================================
+
+#define ICON_GAP     4
+#define TEXT_H      26
+#define MAX_TEXT_W  56  // enough for "-99°C"
+#define SPARK_GAP    1  // px between the text's digits and the sparkline
+
+static struct {
+  char            text[8];
+  GRect           text_rect;
+  GPoint          icon_origin;
+  GPoint          spark_origin;
+  WeatherIconType icon;
+} s_layout;
+
+// Formats and measures the text and centers the widget in bounds.
+// Text measurement is one of the costlier SDK calls, so it runs here once
+// per data update instead of on every frame.
+static void update_layout(GRect bounds) {
   if (s_has_data) {
-    snprintf(temp_buf, sizeof(temp_buf), "%d" "\xc2\xb0" "C", s_temp_c);
+    snprintf(s_layout.text, sizeof(s_layout.text), "%d" "\xc2\xb0" "C", s_temp_c);
   } else {
-    snprintf(temp_buf, sizeof(temp_buf), "--" "\xc2\xb0" "C");
+    snprintf(s_layout.text, sizeof(s_layout.text), "--" "\xc2\xb0" "C");
   }
-  GFont weather_font = fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD);
 
   // Measure actual rendered text width so centering uses real content width
   GSize text_size = graphics_text_layout_get_content_size(
-    temp_buf, weather_font,
+    s_layout.text, s_watchface.text_font,
     GRect(0, 0, MAX_TEXT_W, TEXT_H),
     GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft
   );
   int text_w = text_size.w + 2; // +2 px safety margin
 
   // Center the full widget (icon + gap + text) on the X axis
-  int total_w = ICON_W + GAP + text_w;
-  int start_x = (w - total_w) / 2;
-  int cy      = lh / 2;
+  int total_w = ICON_W + ICON_GAP + text_w;
+  int start_x = (bounds.size.w - total_w) / 2;
+  int cy      = bounds.size.h / 2;
+
+  s_layout.icon        = s_has_data ? s_icon : WeatherIconUnknown;
+  s_layout.icon_origin = GPoint(start_x, cy - ICON_H / 2);
+  s_layout.text_rect   = GRect(start_x + ICON_W + ICON_GAP, cy - TEXT_H / 2, text_w, TEXT_H);
+  // Under the digits, left-aligned with them, in the frame's bottom rows
+  s_layout.spark_origin = GPoint(s_layout.text_rect.origin.x,
+                                 bounds.size.h - SPARKLINE_HEIGHT - SPARK_GAP);
+}
+
+// ============================================================================
+// LAYER UPDATE PROC — draws from the cached layout
+// ============================================================================
+
+static GPoint shifted(GPoint p, GPoint offset) {
+  return GPoint(p.x + offset.x, p.y + offset.y);
+}
+
+// layer is the one ctx draws into; offset is where the weather layer's
+// (0,0) sits in it
+static void draw_weather(Layer *layer, GContext *ctx, GPoint offset) {
+  uint32_t start = profile_begin();
 
   // Draw icon
-  WeatherIconType icon = s_has_data ? s_icon : WeatherIconUnknown;
+  WeatherIconType icon = s_layout.icon;
   if (icon < 7 && s_icon_fns[icon] != NULL) {
-    GPoint icon_origin = GPoint(start_x, cy - ICON_H / 2);
-    s_icon_fns[icon](ctx, icon_origin);
+    draw_icon(ctx, layer, icon, shifted(s_layout.icon_origin, offset));
   }
 
   // Draw temperature text
+  GRect text_rect = s_layout.text_rect;
+  text_rect.origin = shifted(text_rect.origin, offset);
   graphics_context_set_text_color(ctx, GColorWhite);
-  GRect text_rect = GRect(
-    start_x + ICON_W + GAP,
-    cy - TEXT_H / 2,
-    text_w,
-    TEXT_H
-  );
-  graphics_draw_text(ctx, temp_buf, weather_font,
+  graphics_draw_text(ctx, s_layout.text, s_watchface.text_font,
                      text_rect, GTextOverflowModeTrailingEllipsis,
                      GTextAlignmentLeft, NULL);
+
+  // Hourly temperatures ahead, one cached path
+  sparkline_draw(ctx, shifted(s_layout.spark_origin, offset));
+
+  profile_end(ProfileLayerWeather, start);
+}
+
+static void weather_update_proc(Layer *layer, GContext *ctx) {
+  draw_weather(layer, ctx, GPointZero);
+}
+
+// Render scheduler hook — new data lays out once, before the next frame;
+// a theme change drops the cached icons so they re-rasterize in the new accent
+static bool weather_refresh_layout(struct tm *now, uint32_t changed) {
+  if (changed & RenderDepTheme) free_icon_cache(WeatherIconUnknown);
+  update_layout(layer_get_bounds(s_weather_layer));
+  return true;
 }
 
 // ============================================================================
@@ -200,19 +365,14 @@ static void weather_update_proc(Layer *layer, GContext *ctx) {
 // ============================================================================
 
 Layer* weather_layer_create(GRect bounds, Layer *parent) {
-  // Place widget just below the 12 o'clock hour-number label, inside the
-  // clock face interior — no overlap with ring, markers, or hour numbers.
-  // Formula: top of 12 o'clock text = s_center.y - (face_h_edge - num_offset) - 16
-  //          bottom of same text    =                                          + 16
-  int face_h_edge  = s_h_radius - (CLOCK_FACE_STROKE_WIDTH / 2);
-  int num_offset   = MAJOR_MARKER_LENGTH + s_num_offset;
-  int label_bottom = s_center.y - (face_h_edge - num_offset) + 16;
-  int layer_y      = label_bottom + 6;   // 6 px gap below the "12" label
-  int layer_h      = 30;
-  GRect layer_bounds = GRect(0, layer_y, bounds.size.w, layer_h);
+  // Placed just below the 12 o'clock hour-number label (see watchface.c)
+  GRect layer_bounds = s_widget_geometry.weather_frame;
   s_weather_layer = layer_create(layer_bounds);
   layer_set_update_proc(s_weather_layer, weather_update_proc);
   layer_add_child(parent, s_weather_layer);
+  load_weather();
+  update_layout(layer_get_bounds(s_weather_layer));
+  render_register(s_weather_layer, RenderDepWeather | RenderDepTheme, weather_refresh_layout);
   return s_weather_layer;
 }
 
@@ -220,11 +380,44 @@ void weather_layer_set_data(int temp_c, WeatherIconType icon) {
   s_temp_c   = temp_c;
   s_icon     = icon;
   s_has_data = true;
-  if (s_weather_layer) layer_mark_dirty(s_weather_layer);
+  s_updated_at = time(NULL);
+  save_weather();
+  profile_trigger(ProfileTriggerWeather);
+  render_invalidate(RenderDepWeather);
+}
+
+// Leaves s_updated_at and the persisted reading alone: they describe the
+// last message from the phone, which the refresh scheduler ages from
+void weather_layer_show_forecast(int temp_c, WeatherIconType icon) {
+  if (s_has_data && s_temp_c == temp_c && s_icon == icon) return;
+  s_temp_c   = temp_c;
+  s_icon     = icon;
+  s_has_data = true;
+  render_invalidate(RenderDepWeather);
+}
+
+void weather_layer_composite(Layer *target, GContext *ctx) {
+  if (!s_weather_layer || layer_get_hidden(s_weather_layer)) return;
+  draw_weather(target, ctx, layer_get_frame(s_weather_layer).origin);
+}
+
+// Created by a deferred startup stage, so it may not exist yet. The size
+// never changes, so the text and icon layout stays valid
+void weather_layer_move(GRect frame) {
+  if (!s_weather_layer) return;
+  bool hidden = frame.size.h == 0;
+  if (!hidden) layer_set_frame(s_weather_layer, frame);
+  layer_set_hidden(s_weather_layer, hidden);
+}
+
+time_t weather_layer_get_updated_at(void) {
+  return s_has_data ? s_updated_at : 0;
 }
 
 void weather_layer_destroy(void) {
+  free_icon_cache(WeatherIconUnknown);
   if (s_weather_layer) {
+    render_unregister(s_weather_layer);
     layer_destroy(s_weather_layer);
     s_weather_layer = NULL;
   }
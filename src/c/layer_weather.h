@@ -12,12 +12,32 @@ typedef enum {
   WeatherIconUnknown = 7,
 } WeatherIconType;
 
+// Stored readings older than this are not shown at startup
+#define WEATHER_MAX_AGE_S  (3 * 60 * 60)
+
 // Creates the weather widget layer in the top quarter of the screen.
-// Parent layer is the window root layer.
+// Parent layer is the window root layer. Shows the last persisted reading
+// right away if it is recent enough.
 Layer* weather_layer_create(GRect bounds, Layer *parent);
 
-// Updates the displayed temperature and icon. Call from inbox_received_callback.
+// Updates the displayed temperature and icon and persists them.
+// Call from inbox_received_callback.
 void weather_layer_set_data(int temp_c, WeatherIconType icon);
 
+// Shows a forecast hour's temperature and icon without counting it as a new
+// reading: the received time and the persisted reading stay as they were
+void weather_layer_show_forecast(int temp_c, WeatherIconType icon);
+
+// Moves the layer to frame, a rect from watchface_fit_widgets; GRectZero
+// hides it until a frame that fits comes back
+void weather_layer_move(GRect frame);
+
+// Draws the widget at the layer's frame into target, a layer in the same
+// coordinates as the weather layer's parent (compositor.h)
+void weather_layer_composite(Layer *target, GContext *ctx);
+
+// When the displayed reading was received, or 0 if there is none
+time_t weather_layer_get_updated_at(void);
+
 // Destroys the weather layer — call from main_window_unload.
 void weather_layer_destroy(void);
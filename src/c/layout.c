@@ -0,0 +1,80 @@
+#include "layout.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static Layer        *s_root;
+static Layer        *s_clock_layer;
+static LayoutHandler s_fit_widgets;
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+#if PBL_API_EXISTS(layer_get_unobstructed_bounds)
+// Keeps the face centered in whatever part of the screen is still visible.
+// layer_set_frame only marks the moved region dirty; the cached face is
+// blitted at the new position, so an animation step costs one frame. Only
+// the widget rects are fitted again, to the part of the container in view
+static void follow_unobstructed_area(void) {
+  GRect full    = layer_get_bounds(s_root);
+  GRect visible = layer_get_unobstructed_bounds(s_root);
+  int   dy      = (visible.origin.y + visible.size.h / 2) - (full.origin.y + full.size.h / 2);
+
+  GRect frame = layer_get_frame(s_clock_layer);
+  if (frame.origin.y == dy) return;
+  frame.origin.y = dy;
+  layer_set_frame(s_clock_layer, frame);
+  s_fit_widgets(layout_get_area());
+}
+
+// Every step of the peek animation, with the area at that step
+static void unobstructed_change(AnimationProgress progress, void *context) {
+  follow_unobstructed_area();
+}
+
+// The steps may stop short of the final area; settle on it
+static void unobstructed_did_change(void *context) {
+  follow_unobstructed_area();
+}
+#endif
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+Layer* layout_create(Layer *root, LayoutHandler fit_widgets) {
+  s_root        = root;
+  s_fit_widgets = fit_widgets;
+  s_clock_layer = layer_create(layer_get_bounds(root));
+  layer_add_child(root, s_clock_layer);
+
+  #if PBL_API_EXISTS(layer_get_unobstructed_bounds)
+  // A peek may already be showing when the face launches
+  follow_unobstructed_area();
+  unobstructed_area_service_subscribe((UnobstructedAreaHandlers) {
+    .change     = unobstructed_change,
+    .did_change = unobstructed_did_change,
+  }, NULL);
+  #endif
+  return s_clock_layer;
+}
+
+GRect layout_get_area(void) {
+  #if PBL_API_EXISTS(layer_get_unobstructed_bounds)
+  GRect area = layer_get_unobstructed_bounds(s_root);
+  area.origin.y -= layer_get_frame(s_clock_layer).origin.y;
+  return area;
+  #else
+  return layer_get_bounds(s_root);
+  #endif
+}
+
+void layout_destroy(void) {
+  #if PBL_API_EXISTS(layer_get_unobstructed_bounds)
+  unobstructed_area_service_unsubscribe();
+  #endif
+  layer_destroy(s_clock_layer);
+  s_clock_layer = NULL;
+}
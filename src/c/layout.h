@@ -0,0 +1,27 @@
+#pragma once
+#include <pebble.h>
+
+// Clock container — every watchface layer is a child of one full-screen
+// layer, so the whole face can be moved with a single layer_set_frame.
+// When a timeline peek or quick view covers part of the screen the container
+// follows the unobstructed area's center on every animation step. All
+// geometry is container-local and stays as built (or in the const tables);
+// only the widget rects are fitted to the visible part, through the
+// LayoutHandler, so in a short area they slide in or hide instead of being
+// cut off. Where the unobstructed-area API does not exist (aplite) the
+// container just stays put.
+
+// Called with the visible area, in container coordinates, after each move
+typedef void (*LayoutHandler)(GRect area);
+
+// Creates the container inside root and subscribes to unobstructed-area
+// changes. Create the watchface layers with the returned layer as parent.
+// fit_widgets may run before they exist
+Layer* layout_create(Layer *root, LayoutHandler fit_widgets);
+
+// The part of the container currently visible, in container coordinates
+GRect layout_get_area(void);
+
+// Unsubscribes and destroys the container — call after the child layers
+// have been destroyed
+void layout_destroy(void);
@@ -1,23 +1,47 @@
 #include <pebble.h>
 #include "watchface.h"
 #include "layer_face.h"
+#include "layer_date.h"
 #include "layer_hands.h"
+#include "layer_seconds.h"
 #include "layer_weather.h"
+#include "weather_refresh.h"
+#include "weather_forecast.h"
+#include "sparkline.h"
+#include "power_governor.h"
+#include "battery_policy.h"
+#include "render_scheduler.h"
+#include "layout.h"
+#include "compositor.h"
+#include "theme.h"
+#include "second_tz.h"
+#include "bench.h"
+#include "profile.h"
+#include "scenario.h"
+#include "startup.h"
 
 // ============================================================================
 // PRIVATE STATE
 // ============================================================================
 
 static Window *s_main_window;
+static Layer  *s_clock_layer;  // parent of every watchface layer
 
 // ============================================================================
 // EVENT HANDLERS
 // ============================================================================
 
-// Only marks the hands layer dirty — face layer is never touched after init
-void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
-  // Exposed externally so layer_hands.c can restore it after seconds hide
-  hands_layer_mark_dirty();
+// The tick only reports what changed; the render scheduler decides which
+// layers that touches (hands on the minute, date on the day, face highlight
+// on the hour, the small seconds layer while shake mode is on)
+static void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
+  profile_trigger(ProfileTriggerTick);
+  profile_report_if_due(units_changed);
+  power_governor_tick(units_changed);
+
+  render_invalidate_ticks(units_changed);
+  if (units_changed & HOUR_UNIT)   weather_forecast_advance();
+  if (units_changed & MINUTE_UNIT) weather_refresh_tick();
 }
 
 // ============================================================================
@@ -25,6 +49,25 @@ void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
 // ============================================================================
 
 static void inbox_received_callback(DictionaryIterator *iterator, void *context) {
+  // No-op unless built with WATCHFACE_PROFILE=1
+  profile_inbox_received(iterator);
+
+  // Theme preset index from the configuration page
+  Tuple *theme_tuple = dict_find(iterator, MESSAGE_KEY_THEME);
+  if (theme_tuple) theme_set((int)theme_tuple->value->int32);
+
+  // Second time zone offset, minutes east of UTC (out of range = off)
+  Tuple *tz_tuple = dict_find(iterator, MESSAGE_KEY_SECOND_TZ);
+  if (tz_tuple) second_tz_set(tz_tuple->value->int32);
+
+  // Packed current conditions + hourly forecast batch
+  Tuple *packed_tuple = dict_find(iterator, MESSAGE_KEY_WEATHER_PACKED);
+  if (packed_tuple) {
+    weather_forecast_set_packed(packed_tuple->value->data, packed_tuple->length);
+    return;
+  }
+
+  // Legacy pair of int32 tuples
   Tuple *temp_tuple = dict_find(iterator, MESSAGE_KEY_TEMPERATURE);
   Tuple *icon_tuple = dict_find(iterator, MESSAGE_KEY_WEATHER_ICON);
   if (temp_tuple && icon_tuple) {
@@ -35,6 +78,67 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
   }
 }
 
+static void inbox_dropped_callback(AppMessageResult reason, void *context) {
+  APP_LOG(APP_LOG_LEVEL_WARNING, "AppMessage dropped (%d)", (int)reason);
+  profile_inbox_dropped(reason);
+}
+
+// Inbox sized for the largest message pkjs sends, each one carrying a
+// SENT_AT stamp: the packed forecast, or two int32s (THEME and SECOND_TZ,
+// or the legacy TEMPERATURE and WEATHER_ICON pair)
+static uint32_t inbox_size(void) {
+  uint32_t weather  = dict_calc_buffer_size(2, WEATHER_PACKED_MAX, sizeof(int32_t));
+  uint32_t settings = dict_calc_buffer_size(3, sizeof(int32_t), sizeof(int32_t), sizeof(int32_t));
+  return weather > settings ? weather : settings;
+}
+
+// The container moved with a peek: only the widgets near the face's top and
+// bottom edges can end up out of view, so only their rects are fitted again
+static void fit_widgets(GRect area) {
+  WidgetGeometry fit = watchface_fit_widgets(area);
+  date_layer_move(fit.date_rect);
+  weather_layer_move(fit.weather_frame);
+}
+
+// Second stage: the widgets the first frame can do without. Created in
+// draw order, so they still stack above the hands
+static void load_secondary_layers(void) {
+  GRect bounds = layer_get_bounds(s_clock_layer);
+  seconds_layer_create(bounds, s_clock_layer);
+  weather_layer_create(bounds, s_clock_layer);
+  fit_widgets(layout_get_area());
+
+  // No-op unless built with WATCHFACE_PROFILE=1
+  profile_memory("window-load");
+}
+
+// Third stage: phone link and tap input. The weather layer exists by now,
+// so the stored forecast and incoming messages have somewhere to go
+static void start_services(void) {
+  // Charge level and phone link gate seconds, icons and refreshes
+  battery_policy_init();
+  accel_tap_service_subscribe(hands_layer_handle_tap);
+
+  // AppMessage — receive weather from pkjs, send refresh requests back
+  app_message_register_inbox_received(inbox_received_callback);
+  app_message_register_inbox_dropped(inbox_dropped_callback);
+  weather_refresh_init();
+  weather_forecast_init();
+  app_message_open(inbox_size(), weather_refresh_outbox_size());
+
+  // No-op unless built with WATCHFACE_SCENARIO=1
+  scenario_start((ScenarioHooks) {
+    .tick  = tick_handler,
+    .tap   = hands_layer_handle_tap,
+    .inbox = inbox_received_callback,
+  });
+}
+
+// Last stage: fill the face cache on the next frame
+static void warm_caches(void) {
+  face_layer_warm_cache();
+}
+
 static void main_window_load(Window *window) {
   Layer *root   = window_get_root_layer(window);
   GRect  bounds = layer_get_bounds(root);
@@ -42,16 +146,37 @@ static void main_window_load(Window *window) {
   // Init shared geometry and font once
   watchface_geometry_init(bounds);
 
-  // Create layers in draw order: face first (bottom), hands on top, weather on top
-  face_layer_create(bounds, root);
-  hands_layer_create(bounds, root);
-  weather_layer_create(bounds, root);
+  // Only what the first frame shows: face (drawn from primitives until
+  // warm_caches), date and hands. Draw order is face first (bottom),
+  // date, hands, then seconds and weather on top once load_secondary_layers
+  // runs. They all live in one container that follows the unobstructed area
+  // — or, built with WATCHFACE_COMPOSITOR=1, in a hidden stash inside it
+  // while a single layer draws them all
+  s_clock_layer = layout_create(root, fit_widgets);
+  #if defined(WATCHFACE_COMPOSITOR)
+  s_clock_layer = compositor_create(bounds, s_clock_layer);
+  #endif
+  face_layer_create(bounds, s_clock_layer);
+  date_layer_create(bounds, s_clock_layer);
+  hands_layer_create(bounds, s_clock_layer);
+  fit_widgets(layout_get_area());
+  startup_defer(load_secondary_layers);
+
+  // No-op unless built with WATCHFACE_BENCH=1
+  bench_run(bounds);
 }
 
 static void main_window_unload(Window *window) {
+  render_deinit();
   face_layer_destroy();
+  date_layer_destroy();
   hands_layer_destroy();
+  seconds_layer_destroy();
   weather_layer_destroy();
+  #if defined(WATCHFACE_COMPOSITOR)
+  compositor_destroy();
+  #endif
+  layout_destroy();
 }
 
 // ============================================================================
@@ -59,6 +184,8 @@ static void main_window_unload(Window *window) {
 // ============================================================================
 
 static void init(void) {
+  theme_init();
+  second_tz_init();
   s_main_window = window_create();
   window_set_background_color(s_main_window, GColorBlack);
   window_set_window_handlers(s_main_window, (WindowHandlers) {
@@ -66,20 +193,21 @@ static void init(void) {
     .unload = main_window_unload
   });
   window_stack_push(s_main_window, true);
-  tick_timer_service_subscribe(MINUTE_UNIT, tick_handler);
-  accel_tap_service_subscribe(hands_layer_handle_tap);
-
-  // AppMessage — receive weather from pkjs
-  app_message_register_inbox_received(inbox_received_callback);
-  app_message_open(128, 0);
+  power_governor_init(tick_handler);
+  startup_defer(start_services);
+  startup_defer(warm_caches);
 }
 
 static void deinit(void) {
   accel_tap_service_unsubscribe();
+  power_governor_deinit();
+  battery_policy_deinit();
+  sparkline_deinit();
   window_destroy(s_main_window);
 }
 
 int main(void) {
+  startup_begin();
   init();
   app_event_loop();
   deinit();
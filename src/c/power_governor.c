@@ -0,0 +1,100 @@
+#include "power_governor.h"
+#include "render_scheduler.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static TickHandler s_tick_handler;
+static bool        s_seconds       = false;
+static bool        s_low           = false;
+static int         s_still_minutes = 0;
+#if defined(PBL_HEALTH)
+static HealthValue s_last_steps    = 0;
+#endif
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+// True if the wearer moved since the last check
+static bool steps_changed(void) {
+  #if defined(PBL_HEALTH)
+  HealthValue steps = health_service_sum_today(HealthMetricStepCount);
+  bool changed = (steps != s_last_steps);
+  s_last_steps = steps;
+  return changed;
+  #else
+  return false;
+  #endif
+}
+
+static bool wearer_is_resting(void) {
+  #if !defined(PBL_PLATFORM_APLITE)
+  if (quiet_time_is_active()) return true;
+  #endif
+  #if defined(PBL_HEALTH)
+  HealthActivityMask activities = health_service_peek_current_activities();
+  if (activities & (HealthActivitySleep | HealthActivityRestfulSleep)) return true;
+  #endif
+  return s_still_minutes >= POWER_STILL_MINUTES;
+}
+
+static void set_low(bool low) {
+  if (low == s_low) return;
+  s_low = low;
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Power governor: %s cadence", low ? "low" : "full");
+
+  // The snapped minute hand must catch up as soon as full cadence resumes
+  if (!low) render_invalidate(RenderDepPower);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void power_governor_init(TickHandler handler) {
+  s_tick_handler = handler;
+  #if defined(PBL_HEALTH)
+  s_last_steps = health_service_sum_today(HealthMetricStepCount);
+  #endif
+  tick_timer_service_subscribe(MINUTE_UNIT, s_tick_handler);
+}
+
+void power_governor_set_seconds(bool enabled) {
+  if (enabled == s_seconds) return;
+  s_seconds = enabled;
+  tick_timer_service_subscribe(enabled ? SECOND_UNIT : MINUTE_UNIT, s_tick_handler);
+}
+
+void power_governor_wake(void) {
+  s_still_minutes = 0;
+  set_low(false);
+}
+
+void power_governor_tick(TimeUnits units_changed) {
+  if (!(units_changed & MINUTE_UNIT)) return;
+
+  if (steps_changed()) {
+    s_still_minutes = 0;
+  } else if (s_still_minutes < POWER_STILL_MINUTES) {
+    s_still_minutes++;
+  }
+  set_low(wearer_is_resting());
+}
+
+bool power_governor_is_low(void) {
+  return s_low;
+}
+
+bool power_governor_should_redraw(struct tm *tick_time) {
+  return !s_low || (tick_time->tm_min % POWER_LOW_REDRAW_MINUTES) == 0;
+}
+
+int power_governor_display_minute(int tm_min) {
+  return s_low ? tm_min - (tm_min % POWER_LOW_REDRAW_MINUTES) : tm_min;
+}
+
+void power_governor_deinit(void) {
+  tick_timer_service_unsubscribe();
+}
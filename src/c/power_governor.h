@@ -0,0 +1,37 @@
+#pragma once
+#include <pebble.h>
+
+// Power governor — owns the tick subscription and drops the face into a
+// low-power cadence while nobody is looking at it:
+//   - during quiet time, while asleep (health platforms), or after
+//     POWER_STILL_MINUTES without a tap or a step
+//   - low power redraws every POWER_LOW_REDRAW_MINUTES with the minute hand
+//     snapped to that step, and weather refreshes stop
+// A tap or new steps return to full cadence immediately.
+
+#define POWER_STILL_MINUTES        30
+#define POWER_LOW_REDRAW_MINUTES   5
+
+// Subscribes handler to minute ticks. Call once from init
+void power_governor_init(TickHandler handler);
+
+// Switches the tick subscription to SECOND_UNIT while seconds are shown
+void power_governor_set_seconds(bool enabled);
+
+// Reports activity (tap) — leaves low power right away
+void power_governor_wake(void);
+
+// Re-evaluates the mode. Call from tick_handler on every tick
+void power_governor_tick(TimeUnits units_changed);
+
+// True while running at the reduced cadence
+bool power_governor_is_low(void);
+
+// Whether a minute tick at tick_time should redraw the hands
+bool power_governor_should_redraw(struct tm *tick_time);
+
+// Minute the hands should show for tm_min — snapped while in low power
+int power_governor_display_minute(int tm_min);
+
+// Unsubscribes from ticks — call from deinit
+void power_governor_deinit(void);
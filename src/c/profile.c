@@ -0,0 +1,255 @@
+#include "profile.h"
+#include "watchface.h"
+
+#if defined(WATCHFACE_PROFILE) || defined(WATCHFACE_SMOOTH_SECONDS)
+
+// ============================================================================
+// FRAME CLOCK — the face is drawn first, so its start opens a frame and the
+// last update proc to end before the next one closes it
+// ============================================================================
+
+static uint32_t s_frame_start_ms = 0;  // 0 until the first face draw
+static uint32_t s_frame_end_ms   = 0;
+
+uint32_t profile_now_ms(void) {
+  time_t   s;
+  uint16_t ms;
+  time_ms(&s, &ms);
+  return (uint32_t)s * 1000 + ms;
+}
+
+// Extends the current frame to now. Returns true with the span of the frame
+// before in closed_ms when layer's start opened a new one
+static bool frame_mark(ProfileLayer layer, uint32_t start_ms, uint32_t now, uint32_t *closed_ms) {
+  bool closed = false;
+  if (layer == ProfileLayerFace) {
+    closed     = s_frame_start_ms != 0;
+    *closed_ms = s_frame_end_ms - s_frame_start_ms;
+    s_frame_start_ms = start_ms;
+  }
+  s_frame_end_ms = now;
+  return closed;
+}
+
+uint32_t profile_frame_ms(void) {
+  return s_frame_start_ms ? s_frame_end_ms - s_frame_start_ms : 0;
+}
+
+#if !defined(WATCHFACE_PROFILE)
+void profile_end(ProfileLayer layer, uint32_t start_ms) {
+  uint32_t frame_ms;
+  frame_mark(layer, start_ms, profile_now_ms(), &frame_ms);
+}
+#endif
+
+#endif
+
+#if defined(WATCHFACE_PROFILE)
+
+// ============================================================================
+// PRIVATE CONSTANTS
+// ============================================================================
+
+// 1 ms buckets; the last bucket collects everything slower
+#define HISTOGRAM_BUCKETS  32
+
+// SENT_AT wraps at 2^31 ms; a stamp ahead of the watch clock (phone and
+// watch disagree) reads as a difference with this bit set
+#define SENT_AT_MASK       0x7fffffff
+#define SENT_AT_AHEAD      0x40000000
+
+// ============================================================================
+// PRIVATE STATE — all static, nothing allocated
+// ============================================================================
+
+typedef struct {
+  uint16_t buckets[HISTOGRAM_BUCKETS];
+  uint16_t by_trigger[ProfileTriggerCount];
+  uint16_t calls;
+  uint16_t min_ms;
+  uint16_t max_ms;
+  uint32_t total_ms;
+} LayerStats;
+
+static const char * const LAYER_NAMES[ProfileLayerCount] = {
+  "face", "date", "hands", "seconds", "weather", "frame"
+};
+
+typedef struct {
+  uint16_t received;
+  uint16_t dropped;
+  uint16_t overflow;      // dropped because the inbox buffer was too small
+  uint16_t timed;         // received with a SENT_AT stamp
+  uint32_t latency_min_ms;
+  uint32_t latency_max_ms;
+  uint32_t latency_total_ms;
+  uint16_t sent;
+  uint16_t busy;
+  uint16_t out_of_memory;
+  uint16_t failed;        // any other outbox result
+} MessageStats;
+
+static LayerStats     s_stats[ProfileLayerCount];
+static MessageStats   s_messages;
+static ProfileTrigger s_trigger = ProfileTriggerTick;
+static uint32_t       s_window_start_ms;
+static int            s_minutes = 0;
+static bool           s_periodic = true;
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+static void reset_stats(void) {
+  memset(s_stats, 0, sizeof(s_stats));
+  for (int i = 0; i < ProfileLayerCount; i++) s_stats[i].min_ms = UINT16_MAX;
+  memset(&s_messages, 0, sizeof(s_messages));
+  s_messages.latency_min_ms = UINT32_MAX;
+  s_window_start_ms = profile_now_ms();
+}
+
+// Smallest bucket at or below which 95% of the calls fall
+static int percentile_95(const LayerStats *st) {
+  uint32_t target = (st->calls * 95 + 99) / 100;
+  uint32_t seen   = 0;
+  for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+    seen += st->buckets[b];
+    if (seen >= target) return b;
+  }
+  return HISTOGRAM_BUCKETS - 1;
+}
+
+static void log_summary(const char *label) {
+  uint32_t window_ms = profile_now_ms() - s_window_start_ms;
+  uint32_t frames    = s_stats[ProfileLayerFace].calls;
+
+  // The face layer is at the bottom of the tree, so it runs once per frame
+  APP_LOG(APP_LOG_LEVEL_INFO, "profile [%s] %lu frames in %lu s (%lu frames/min)",
+          label, (unsigned long)frames, (unsigned long)(window_ms / 1000),
+          (unsigned long)(window_ms ? frames * 60000 / window_ms : 0));
+
+  for (int i = 0; i < ProfileLayerCount; i++) {
+    const LayerStats *st = &s_stats[i];
+    if (st->calls == 0) continue;
+    APP_LOG(APP_LOG_LEVEL_INFO,
+            "profile %-7s n=%u min=%u avg=%lu max=%u p95=%d%s ms tick=%u tap=%u weather=%u",
+            LAYER_NAMES[i], st->calls, st->min_ms,
+            (unsigned long)(st->total_ms / st->calls), st->max_ms,
+            percentile_95(st), percentile_95(st) == HISTOGRAM_BUCKETS - 1 ? "+" : "",
+            st->by_trigger[ProfileTriggerTick], st->by_trigger[ProfileTriggerTap],
+            st->by_trigger[ProfileTriggerWeather]);
+  }
+
+  const MessageStats *msg = &s_messages;
+  if (msg->received == 0 && msg->dropped == 0 && msg->sent == 0 &&
+      msg->busy == 0 && msg->out_of_memory == 0 && msg->failed == 0) {
+    return;
+  }
+  APP_LOG(APP_LOG_LEVEL_INFO,
+          "profile inbox n=%u dropped=%u overflow=%u latency min=%lu avg=%lu max=%lu ms",
+          msg->received, msg->dropped, msg->overflow,
+          (unsigned long)(msg->timed ? msg->latency_min_ms : 0),
+          (unsigned long)(msg->timed ? msg->latency_total_ms / msg->timed : 0),
+          (unsigned long)msg->latency_max_ms);
+  APP_LOG(APP_LOG_LEVEL_INFO, "profile outbox sent=%u busy=%u oom=%u failed=%u",
+          msg->sent, msg->busy, msg->out_of_memory, msg->failed);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void profile_trigger(ProfileTrigger trigger) {
+  s_trigger = trigger;
+}
+
+static void record(ProfileLayer layer, uint32_t elapsed) {
+  LayerStats *st = &s_stats[layer];
+  if (st->calls == UINT16_MAX) return;  // saturated until the next report
+
+  st->buckets[elapsed < HISTOGRAM_BUCKETS ? elapsed : HISTOGRAM_BUCKETS - 1]++;
+  st->by_trigger[s_trigger]++;
+  st->calls++;
+  st->total_ms += elapsed;
+  if (elapsed < st->min_ms) st->min_ms = elapsed;
+  if (elapsed > st->max_ms) st->max_ms = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+}
+
+void profile_end(ProfileLayer layer, uint32_t start_ms) {
+  if (s_window_start_ms == 0) reset_stats();
+
+  uint32_t now = profile_now_ms();
+  uint32_t frame_ms;
+  if (frame_mark(layer, start_ms, now, &frame_ms)) record(ProfileLayerFrame, frame_ms);
+  record(layer, now - start_ms);
+}
+
+void profile_report_if_due(TimeUnits units_changed) {
+  if (!s_periodic) return;
+  if (!(units_changed & MINUTE_UNIT)) return;  // ignore shake-mode second ticks
+  if (++s_minutes < PROFILE_REPORT_MINUTES) return;
+  s_minutes = 0;
+  profile_report("periodic");
+}
+
+void profile_report(const char *label) {
+  log_summary(label);
+  reset_stats();
+}
+
+void profile_set_periodic(bool enabled) {
+  s_periodic = enabled;
+  s_minutes  = 0;
+}
+
+void profile_inbox_received(DictionaryIterator *iter) {
+  if (s_window_start_ms == 0) reset_stats();
+  MessageStats *msg = &s_messages;
+  if (msg->received < UINT16_MAX) msg->received++;
+
+  Tuple *sent_at = dict_find(iter, MESSAGE_KEY_SENT_AT);
+  if (!sent_at || msg->timed == UINT16_MAX) return;
+  uint32_t latency = (profile_now_ms() - (uint32_t)sent_at->value->int32) & SENT_AT_MASK;
+  if (latency & SENT_AT_AHEAD) latency = 0;
+
+  msg->timed++;
+  msg->latency_total_ms += latency;
+  if (latency < msg->latency_min_ms) msg->latency_min_ms = latency;
+  if (latency > msg->latency_max_ms) msg->latency_max_ms = latency;
+}
+
+void profile_inbox_dropped(AppMessageResult reason) {
+  if (s_window_start_ms == 0) reset_stats();
+  if (s_messages.dropped < UINT16_MAX) s_messages.dropped++;
+  if (reason == APP_MSG_BUFFER_OVERFLOW && s_messages.overflow < UINT16_MAX) {
+    s_messages.overflow++;
+  }
+}
+
+void profile_outbox_result(AppMessageResult result) {
+  if (s_window_start_ms == 0) reset_stats();
+  uint16_t *counter;
+  switch (result) {
+    case APP_MSG_OK:            counter = &s_messages.sent;          break;
+    case APP_MSG_BUSY:          counter = &s_messages.busy;          break;
+    case APP_MSG_OUT_OF_MEMORY: counter = &s_messages.out_of_memory; break;
+    default:                    counter = &s_messages.failed;        break;
+  }
+  if (*counter < UINT16_MAX) (*counter)++;
+}
+
+void profile_memory(const char *label) {
+  APP_LOG(APP_LOG_LEVEL_INFO, "profile heap [%s] used=%u free=%u",
+          label, (unsigned)heap_bytes_used(), (unsigned)heap_bytes_free());
+
+  // Generated geometry tables are const and stay in the binary's rodata
+  #if defined(WATCHFACE_GEOMETRY_TABLES)
+  unsigned tables = 0;
+  #else
+  unsigned tables = sizeof(FaceGeometry) + sizeof(HandsGeometry) + sizeof(WidgetGeometry);
+  #endif
+  APP_LOG(APP_LOG_LEVEL_INFO, "profile statics context=%u geometry=%u",
+          (unsigned)sizeof(WatchfaceContext), tables);
+}
+
+#endif
@@ -0,0 +1,100 @@
+#pragma once
+#include <pebble.h>
+
+// Opt-in render-time instrumentation. Only compiled in with WATCHFACE_PROFILE=1
+// (see wscript); otherwise every call below is an empty inline — except the
+// frame clock (profile_begin/profile_end/profile_frame_ms), which
+// WATCHFACE_SMOOTH_SECONDS=1 keeps as well because the sweep paces itself on
+// the full frame.
+//
+// Each update proc is timestamped with time_ms and folded into a fixed-size
+// per-layer histogram (min/avg/max/p95). A "frame" entry spans each frame
+// from the face's start to the last end, so the firmware's traversal
+// between layers counts too — what the WATCHFACE_COMPOSITOR build saves.
+// Frames are attributed to whatever last invalidated the screen (tick, tap,
+// weather), and a summary is written to APP_LOG every
+// PROFILE_REPORT_MINUTES.
+//
+// The same report counts AppMessage traffic: inbox messages received and
+// dropped (overflow = inbox buffer too small), transfer latency from the
+// SENT_AT stamp pkjs puts on each message, and outbox results.
+
+typedef enum {
+  ProfileLayerFace = 0,
+  ProfileLayerDate,
+  ProfileLayerHands,
+  ProfileLayerSeconds,
+  ProfileLayerWeather,
+  ProfileLayerFrame,  // face start to the last update proc's end, traversal included
+  ProfileLayerCount,
+} ProfileLayer;
+
+typedef enum {
+  ProfileTriggerTick = 0,
+  ProfileTriggerTap,
+  ProfileTriggerWeather,
+  ProfileTriggerCount,
+} ProfileTrigger;
+
+#define PROFILE_REPORT_MINUTES  5
+
+#if defined(WATCHFACE_PROFILE) || defined(WATCHFACE_SMOOTH_SECONDS)
+
+// Milliseconds since the epoch, truncated — only differences are meaningful
+uint32_t profile_now_ms(void);
+
+// Call at the top of an update proc; pass the result to profile_end
+static inline uint32_t profile_begin(void) { return profile_now_ms(); }
+void profile_end(ProfileLayer layer, uint32_t start_ms);
+
+// Span of the latest frame, face start to the last update proc's end — the
+// whole frame when called outside a render pass. 0 before the first frame
+uint32_t profile_frame_ms(void);
+
+#else
+
+static inline uint32_t profile_now_ms(void) { return 0; }
+static inline uint32_t profile_begin(void) { return 0; }
+static inline void     profile_end(ProfileLayer layer, uint32_t start_ms) { }
+static inline uint32_t profile_frame_ms(void) { return 0; }
+
+#endif
+
+#if defined(WATCHFACE_PROFILE)
+
+// Records what caused the next frame(s)
+void profile_trigger(ProfileTrigger trigger);
+
+// Call from tick_handler — logs and resets the summary when it's due
+void profile_report_if_due(TimeUnits units_changed);
+
+// Logs the summary now under a label and starts a new window. Turning the
+// periodic report off lets a benchmark driver decide the windows itself.
+void profile_report(const char *label);
+void profile_set_periodic(bool enabled);
+
+// Logs heap used/free and the RAM taken by the shared context and geometry
+// tables, under a label (main.c reports after window load). Per-module
+// static sizes come from the build: WATCHFACE_MEMORY_REPORT=1 (see wscript)
+void profile_memory(const char *label);
+
+// Call from the AppMessage callbacks. The inbox one reads SENT_AT (phone
+// time, ms since the epoch mod 2^31) against the watch's receive time; the
+// outbox one takes APP_MSG_OK for a sent message, or the failure result of
+// a begin, send or failed callback
+void profile_inbox_received(DictionaryIterator *iter);
+void profile_inbox_dropped(AppMessageResult reason);
+void profile_outbox_result(AppMessageResult result);
+
+#else
+
+static inline void     profile_trigger(ProfileTrigger trigger) { }
+static inline void     profile_report_if_due(TimeUnits units_changed) { }
+static inline void     profile_report(const char *label) { }
+static inline void     profile_set_periodic(bool enabled) { }
+static inline void     profile_memory(const char *label) { }
+static inline void     profile_inbox_received(DictionaryIterator *iter) { }
+static inline void     profile_inbox_dropped(AppMessageResult reason) { }
+static inline void     profile_outbox_result(AppMessageResult result) { }
+
+#endif
@@ -0,0 +1,86 @@
+#include "render_scheduler.h"
+#include "watchface.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+typedef struct {
+  Layer         *layer;
+  uint32_t       deps;
+  RenderRefresh  refresh;
+} RenderClient;
+
+static RenderClient s_clients[RENDER_MAX_CLIENTS];
+static int          s_client_count = 0;
+static uint32_t     s_pending      = 0;     // RenderDep bits since the last flush
+static AppTimer    *s_flush_timer  = NULL;
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+static void flush(void *context) {
+  s_flush_timer = NULL;
+  uint32_t pending = s_pending;
+  s_pending = 0;
+
+  struct tm *now = watchface_localtime();
+  for (int i = 0; i < s_client_count; i++) {
+    RenderClient *client  = &s_clients[i];
+    uint32_t      changed = client->deps & pending;
+    if (!changed) continue;
+    if (!client->refresh || client->refresh(now, changed)) {
+      layer_mark_dirty(client->layer);
+    }
+  }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void render_register(Layer *layer, uint32_t deps, RenderRefresh refresh) {
+  if (s_client_count >= RENDER_MAX_CLIENTS) {
+    APP_LOG(APP_LOG_LEVEL_ERROR, "render_register: RENDER_MAX_CLIENTS reached");
+    return;
+  }
+  s_clients[s_client_count++] = (RenderClient) {
+    .layer   = layer,
+    .deps    = deps,
+    .refresh = refresh,
+  };
+}
+
+void render_unregister(Layer *layer) {
+  for (int i = 0; i < s_client_count; i++) {
+    if (s_clients[i].layer != layer) continue;
+    s_clients[i] = s_clients[--s_client_count];
+    return;
+  }
+}
+
+void render_invalidate(uint32_t changed) {
+  s_pending |= changed;
+  if (!s_flush_timer && s_client_count > 0) {
+    s_flush_timer = app_timer_register(0, flush, NULL);
+  }
+}
+
+void render_invalidate_ticks(TimeUnits units_changed) {
+  uint32_t changed = 0;
+  if (units_changed & SECOND_UNIT) changed |= RenderDepSecond;
+  if (units_changed & MINUTE_UNIT) changed |= RenderDepMinute;
+  if (units_changed & HOUR_UNIT)   changed |= RenderDepHour;
+  if (units_changed & DAY_UNIT)    changed |= RenderDepDay;
+  render_invalidate(changed);
+}
+
+void render_deinit(void) {
+  if (s_flush_timer) {
+    app_timer_cancel(s_flush_timer);
+    s_flush_timer = NULL;
+  }
+  s_pending      = 0;
+  s_client_count = 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <pebble.h>
+
+// Render scheduler — the one place that decides which layers get marked
+// dirty. Each layer registers the inputs it depends on; events report what
+// changed, and the scheduler flushes once per event-loop turn (0 ms
+// AppTimer), so a tick that also moves the hour and the day still touches
+// each layer at most once.
+
+typedef enum {
+  RenderDepMinute   = 1 << 0,
+  RenderDepHour     = 1 << 1,
+  RenderDepDay      = 1 << 2,
+  RenderDepSecond   = 1 << 3,
+  RenderDepWeather  = 1 << 4,
+  RenderDepTap      = 1 << 5,  // shake-to-show state toggled
+  RenderDepPower    = 1 << 6,  // power governor changed cadence
+  RenderDepTheme    = 1 << 7,  // theme_set picked new colors
+  RenderDepSecondTz = 1 << 8,  // second_tz_set changed the GMT hand
+} RenderDep;
+
+#define RENDER_MAX_CLIENTS  8
+
+// Called at flush with the subset of the layer's inputs that changed.
+// Refreshes cached state and returns true if the layer must be redrawn
+typedef bool (*RenderRefresh)(struct tm *now, uint32_t changed);
+
+// Registers layer for the inputs in deps. refresh may be NULL (always redraw)
+void render_register(Layer *layer, uint32_t deps, RenderRefresh refresh);
+
+// Drops layer — call before layer_destroy
+void render_unregister(Layer *layer);
+
+// Reports changed inputs (RenderDep mask); flushed on the next loop turn
+void render_invalidate(uint32_t changed);
+
+// Maps a tick's TimeUnits onto RenderDep bits and invalidates them
+void render_invalidate_ticks(TimeUnits units_changed);
+
+// Cancels a pending flush — call from main_window_unload
+void render_deinit(void);
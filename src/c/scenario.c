@@ -0,0 +1,139 @@
+#include "scenario.h"
+
+#if defined(WATCHFACE_SCENARIO)
+#include "watchface.h"
+#include "layer_weather.h"
+#include "profile.h"
+
+// ============================================================================
+// PRIVATE CONSTANTS
+// ============================================================================
+
+#define SCENARIO_START_DELAY     2000  // ms — let startup settle first
+#define SCENARIO_TICK_MS         40    // gap between simulated minute ticks
+#define SCENARIO_MINUTE_TICKS    (24 * 60)
+#define SCENARIO_SHAKE_BURSTS    5
+#define SCENARIO_SHAKE_GAP_MS    (SECONDS_DISPLAY_DURATION + 1000)
+#define SCENARIO_WEATHER_PUSHES  24
+#define SCENARIO_WEATHER_MS      250
+
+typedef enum {
+  ScenarioPhaseMinuteTicks = 0,
+  ScenarioPhaseShakeBursts,
+  ScenarioPhaseWeather,
+  ScenarioPhaseDone,
+} ScenarioPhase;
+
+static const char * const PHASE_NAMES[] = {
+  "minute-ticks", "shake-bursts", "weather-pushes"
+};
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static ScenarioHooks s_hooks;
+static ScenarioPhase s_phase;
+static int           s_step;
+static int32_t       s_offset;  // simulated seconds ahead of the real clock
+
+// ============================================================================
+// PRIVATE: STEPS
+// ============================================================================
+
+static void log_heap(const char *label) {
+  APP_LOG(APP_LOG_LEVEL_INFO, "scenario heap [%s] used=%u free=%u",
+          label, (unsigned)heap_bytes_used(), (unsigned)heap_bytes_free());
+}
+
+// Advances the simulated clock one minute and delivers the tick
+static void step_minute_tick(void) {
+  s_offset += 60;
+  watchface_set_time_offset(s_offset);
+
+  struct tm *t     = watchface_localtime();
+  TimeUnits  units = MINUTE_UNIT;
+  if (t->tm_min == 0)                    units |= HOUR_UNIT;
+  if (t->tm_min == 0 && t->tm_hour == 0) units |= DAY_UNIT;
+  s_hooks.tick(t, units);
+}
+
+// Builds a real AppMessage dictionary so the inbox parsing path is exercised
+static void step_weather_push(int n) {
+  static uint8_t buffer[64];
+  DictionaryIterator iter;
+  dict_write_begin(&iter, buffer, sizeof(buffer));
+  dict_write_int32(&iter, MESSAGE_KEY_TEMPERATURE, (n * 7) % 60 - 20);
+  dict_write_int32(&iter, MESSAGE_KEY_WEATHER_ICON, n % (WeatherIconUnknown + 1));
+  uint32_t size = dict_write_end(&iter);
+
+  DictionaryIterator read;
+  dict_read_begin_from_buffer(&read, buffer, size);
+  s_hooks.inbox(&read, NULL);
+}
+
+// Runs one step of the current phase; returns the delay before the next one
+static uint32_t run_step(void) {
+  switch (s_phase) {
+    case ScenarioPhaseMinuteTicks:
+      if (s_step >= SCENARIO_MINUTE_TICKS) return 0;
+      step_minute_tick();
+      return SCENARIO_TICK_MS;
+    case ScenarioPhaseShakeBursts:
+      if (s_step >= SCENARIO_SHAKE_BURSTS) return 0;
+      s_hooks.tap(ACCEL_AXIS_Z, 1);
+      return SCENARIO_SHAKE_GAP_MS;
+    case ScenarioPhaseWeather:
+      if (s_step >= SCENARIO_WEATHER_PUSHES) return 0;
+      step_weather_push(s_step);
+      return SCENARIO_WEATHER_MS;
+    default:
+      return 0;
+  }
+}
+
+static void scenario_timer_callback(void *context) {
+  uint32_t delay = run_step();
+
+  if (delay == 0) {
+    // Phase finished — report it and move on
+    profile_report(PHASE_NAMES[s_phase]);
+    log_heap(PHASE_NAMES[s_phase]);
+    s_phase++;
+    s_step = 0;
+
+    if (s_phase == ScenarioPhaseDone) {
+      watchface_set_time_offset(0);
+      APP_LOG(APP_LOG_LEVEL_INFO, "scenario done");
+      return;
+    }
+    delay = SCENARIO_TICK_MS;
+  } else {
+    s_step++;
+  }
+
+  app_timer_register(delay, scenario_timer_callback, NULL);
+}
+
+static void scenario_begin_callback(void *context) {
+  // The suite decides the report windows; start from a clean one
+  profile_set_periodic(false);
+  profile_report("startup");
+  log_heap("startup");
+  scenario_timer_callback(NULL);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void scenario_start(ScenarioHooks hooks) {
+  s_hooks  = hooks;
+  s_phase  = ScenarioPhaseMinuteTicks;
+  s_step   = 0;
+  s_offset = 0;
+  APP_LOG(APP_LOG_LEVEL_INFO, "scenario start");
+  app_timer_register(SCENARIO_START_DELAY, scenario_begin_callback, NULL);
+}
+
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+#include <pebble.h>
+
+// Scripted benchmark scenario for the emulator performance suite
+// (tools/emu_bench.py). Only compiled in with WATCHFACE_SCENARIO=1 (see
+// wscript); otherwise scenario_start is a no-op.
+//
+// Drives the real handlers on a simulated clock: 24 hours of minute ticks,
+// repeated shake bursts, then a series of weather pushes. After each phase it
+// logs a labelled profile summary (needs WATCHFACE_PROFILE=1) plus heap stats,
+// and finally "scenario done".
+
+typedef struct {
+  TickHandler             tick;   // main.c tick_handler
+  AccelTapHandler         tap;    // hands_layer_handle_tap
+  AppMessageInboxReceived inbox;  // main.c inbox_received_callback
+} ScenarioHooks;
+
+#if defined(WATCHFACE_SCENARIO)
+void scenario_start(ScenarioHooks hooks);
+#else
+static inline void scenario_start(ScenarioHooks hooks) { }
+#endif
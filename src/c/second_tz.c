@@ -0,0 +1,64 @@
+#include "second_tz.h"
+#include "watchface.h"
+#include "render_scheduler.h"
+
+#define MINUTES_PER_DAY   (24 * 60)
+#define MINUTES_PER_HALF  (12 * 60)
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static bool    s_enabled = false;
+static int32_t s_offset_minutes = 0;
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+static bool offset_valid(int32_t offset_minutes) {
+  return offset_minutes >= SECOND_TZ_MIN_MINUTES && offset_minutes <= SECOND_TZ_MAX_MINUTES;
+}
+
+// time() is UTC, so the zone's minute of day is plain integer arithmetic —
+// no localtime/gmtime call and no trig
+static int32_t zone_minute_of_day(void) {
+  int32_t minute = (int32_t)((watchface_time() / 60) % MINUTES_PER_DAY) + s_offset_minutes;
+  return ((minute % MINUTES_PER_DAY) + MINUTES_PER_DAY) % MINUTES_PER_DAY;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void second_tz_init(void) {
+  if (!persist_exists(PERSIST_KEY_SECOND_TZ)) return;
+  int32_t offset = persist_read_int(PERSIST_KEY_SECOND_TZ);
+  s_enabled        = offset_valid(offset);
+  s_offset_minutes = s_enabled ? offset : 0;
+}
+
+void second_tz_set(int32_t offset_minutes) {
+  bool enabled = offset_valid(offset_minutes);
+  if (!enabled) offset_minutes = 0;
+  if (enabled == s_enabled && offset_minutes == s_offset_minutes) return;
+
+  s_enabled        = enabled;
+  s_offset_minutes = offset_minutes;
+  if (enabled) {
+    persist_write_int(PERSIST_KEY_SECOND_TZ, offset_minutes);
+  } else {
+    persist_delete(PERSIST_KEY_SECOND_TZ);
+  }
+  render_invalidate(RenderDepSecondTz);
+}
+
+// Two degrees per minute of the half day, the hour hand's own scale
+int second_tz_degrees(void) {
+  if (!s_enabled) return -1;
+  return (zone_minute_of_day() % MINUTES_PER_HALF) / 2;
+}
+
+bool second_tz_is_pm(void) {
+  return zone_minute_of_day() >= MINUTES_PER_HALF;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <pebble.h>
+
+// Second time zone, shown as a GMT hand read against the 12-hour dial like
+// the hour hand, with an AM/PM cue at its tip (layer_hands.c). The offset comes from the
+// SECOND_TZ message key (minutes east of UTC) and is persisted; a value
+// outside SECOND_TZ_MIN/MAX_MINUTES turns the hand off. A change is
+// reported to the render scheduler as RenderDepSecondTz.
+
+#define PERSIST_KEY_SECOND_TZ   4
+#define SECOND_TZ_MIN_MINUTES   (-12 * 60)
+#define SECOND_TZ_MAX_MINUTES   (14 * 60)
+
+// Restores the persisted offset — call before the window is pushed
+void second_tz_init(void);
+
+// Sets the offset in minutes east of UTC, or turns the hand off if out of
+// range, and persists the choice
+void second_tz_set(int32_t offset_minutes);
+
+// Angle of the GMT hand in whole degrees (0..359) on the 12-hour dial at the
+// watch's current time, or -1 while the hand is off. Indexes
+// s_hands_geometry.hour_end
+int second_tz_degrees(void);
+
+// True if it is afternoon or evening in the second zone
+bool second_tz_is_pm(void);
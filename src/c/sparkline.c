@@ -0,0 +1,105 @@
+#include "sparkline.h"
+#include "theme.h"
+#include "render_scheduler.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Mirrored ring: batch entry i lives in slot i % SPARKLINE_POINTS, stored
+// twice (slot and slot + SPARKLINE_POINTS) so the window is always one
+// contiguous run for the path. Points sit at fixed x = position * STEP; the
+// draw offset cancels where the window starts
+static GPoint  s_points[2 * SPARKLINE_POINTS];
+static GPath  *s_path  = NULL;
+static int     s_head  = 0;    // batch entry at the window's start
+static int     s_lo    = 0;    // batch range the y scale was built from
+static int     s_hi    = 0;
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+// Warmer is higher; a flat forecast runs along the middle
+static int scale_y(int temp) {
+  if (s_hi == s_lo) return SPARKLINE_HEIGHT / 2;
+  return (SPARKLINE_HEIGHT - 1) - (temp - s_lo) * (SPARKLINE_HEIGHT - 1) / (s_hi - s_lo);
+}
+
+static void write_entry(const int8_t *temps, int i) {
+  int slot = i % SPARKLINE_POINTS;
+  int y    = scale_y(temps[i]);
+  s_points[slot]                    = GPoint(slot * SPARKLINE_STEP, y);
+  s_points[slot + SPARKLINE_POINTS] = GPoint((slot + SPARKLINE_POINTS) * SPARKLINE_STEP, y);
+}
+
+// Writes entries [from, to) that the batch has
+static void write_entries(const int8_t *temps, int count, int from, int to) {
+  for (int i = from; i < to && i < count; i++) write_entry(temps, i);
+}
+
+static void point_path(int count) {
+  int left = count - s_head;
+  if (left < 0) left = 0;
+  if (left > SPARKLINE_POINTS) left = SPARKLINE_POINTS;
+  s_path->points     = &s_points[s_head % SPARKLINE_POINTS];
+  s_path->num_points = left;
+  render_invalidate(RenderDepWeather);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void sparkline_set(const int8_t *temps, int count, int head) {
+  if (count > WEATHER_FORECAST_MAX) count = WEATHER_FORECAST_MAX;
+  if (head < 0) head = 0;
+  if (!s_path) {
+    s_path = gpath_create(&(GPathInfo) { 0, s_points });
+    if (!s_path) return;
+  }
+
+  s_lo = 127;
+  s_hi = -128;
+  for (int i = 0; i < count; i++) {
+    if (temps[i] < s_lo) s_lo = temps[i];
+    if (temps[i] > s_hi) s_hi = temps[i];
+  }
+
+  s_head = head;
+  write_entries(temps, count, head, head + SPARKLINE_POINTS);
+  point_path(count);
+}
+
+void sparkline_advance(const int8_t *temps, int count, int head) {
+  if (!s_path || head == s_head) return;
+  if (count > WEATHER_FORECAST_MAX) count = WEATHER_FORECAST_MAX;
+
+  // Backwards or more than a window ahead (the clock was set): rebuild
+  if (head < s_head || head - s_head >= SPARKLINE_POINTS) {
+    sparkline_set(temps, count, head);
+    return;
+  }
+
+  // Only the hours entering the window overwrite the slots leaving it
+  write_entries(temps, count, s_head + SPARKLINE_POINTS, head + SPARKLINE_POINTS);
+  s_head = head;
+  point_path(count);
+}
+
+void sparkline_draw(GContext *ctx, GPoint origin) {
+  if (!s_path || s_path->num_points < 2) return;
+  int start = s_head % SPARKLINE_POINTS;
+  gpath_move_to(s_path, GPoint(origin.x - start * SPARKLINE_STEP, origin.y));
+  graphics_context_set_stroke_color(ctx, theme_get()->accent);
+  graphics_context_set_stroke_width(ctx, 1);
+  gpath_draw_outline_open(ctx, s_path);
+}
+
+void sparkline_deinit(void) {
+  if (s_path) {
+    gpath_destroy(s_path);
+    s_path = NULL;
+  }
+  s_head = 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <pebble.h>
+#include "weather_forecast.h"
+
+// Hourly temperature sparkline for the weather widget: the next
+// SPARKLINE_POINTS hours of the forecast batch, cached as one GPath over a
+// ring buffer of points. New data rebuilds the ring; each hour rollover
+// shifts it by one slot, writing only the hour that enters the window, so a
+// frame costs a single open-path stroke. Once fewer than two hours of the
+// batch are left the sparkline is hidden. Changes redraw the weather layer
+// through RenderDepWeather.
+
+#define SPARKLINE_POINTS   8   // hours shown; the batch runs further ahead
+#define SPARKLINE_STEP     3   // px between hourly points
+#define SPARKLINE_HEIGHT   6   // px from the coldest to the warmest point
+#define SPARKLINE_WIDTH    ((SPARKLINE_POINTS - 1) * SPARKLINE_STEP + 1)
+
+// Rebuilds the ring from count hourly temperatures (oldest first), scaled to
+// the batch's own range, with the window starting at entry head
+void sparkline_set(const int8_t *temps, int count, int head);
+
+// Moves the window's start to entry head of the same batch — call when the
+// hour rolls over
+void sparkline_advance(const int8_t *temps, int count, int head);
+
+// Strokes the window with its first point at origin; draws nothing while
+// the sparkline is hidden
+void sparkline_draw(GContext *ctx, GPoint origin);
+
+// Frees the cached path — call from deinit
+void sparkline_deinit(void);
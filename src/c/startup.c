@@ -0,0 +1,62 @@
+#include "startup.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static StartupStage s_stages[STARTUP_MAX_STAGES];
+static int          s_stage_count = 0;
+static int          s_next_stage  = 0;
+static time_t       s_begin_s;
+static uint16_t     s_begin_ms;
+static bool         s_first_frame = false;
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+#if defined(WATCHFACE_PROFILE)
+static uint32_t elapsed_ms(void) {
+  time_t   s;
+  uint16_t ms;
+  time_ms(&s, &ms);
+  return (uint32_t)(s - s_begin_s) * 1000 + ms - s_begin_ms;
+}
+#endif
+
+// Runs one stage, then yields back to the event loop before the next
+static void run_next_stage(void *context) {
+  if (s_next_stage >= s_stage_count) return;
+  s_stages[s_next_stage++]();
+  if (s_next_stage < s_stage_count) app_timer_register(0, run_next_stage, NULL);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void startup_begin(void) {
+  time_ms(&s_begin_s, &s_begin_ms);
+}
+
+void startup_defer(StartupStage stage) {
+  if (s_stage_count >= STARTUP_MAX_STAGES) {
+    // Never silently drop a stage — run it now instead
+    APP_LOG(APP_LOG_LEVEL_WARNING, "startup: more than %d stages", STARTUP_MAX_STAGES);
+    stage();
+    return;
+  }
+  s_stages[s_stage_count++] = stage;
+}
+
+void startup_frame_drawn(void) {
+  if (s_first_frame) return;
+  s_first_frame = true;
+
+  #if defined(WATCHFACE_PROFILE)
+  APP_LOG(APP_LOG_LEVEL_INFO, "profile startup first-frame=%lu ms", (unsigned long)elapsed_ms());
+  #endif
+
+  // Not from inside the update proc: the first stage waits for the next turn
+  app_timer_register(0, run_next_stage, NULL);
+}
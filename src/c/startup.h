@@ -0,0 +1,22 @@
+#pragma once
+#include <pebble.h>
+
+// Staged startup — the window load builds only what the first frame shows
+// (face, date, hands); the rest is queued here and runs after that frame,
+// one stage per event-loop turn, so input and rendering are never held up
+// by more than one stage at a time.
+
+#define STARTUP_MAX_STAGES  4
+
+typedef void (*StartupStage)(void);
+
+// Records the launch time. Call first thing in main
+void startup_begin(void);
+
+// Queues stage to run after the first frame, in the order queued
+void startup_defer(StartupStage stage);
+
+// Call at the end of hands_update_proc. The first call measures the time
+// since startup_begin (logged with WATCHFACE_PROFILE=1) and starts the
+// deferred stages
+void startup_frame_drawn(void);
@@ -0,0 +1,45 @@
+#include "theme.h"
+#include "render_scheduler.h"
+
+// ============================================================================
+// PRIVATE CONSTANTS
+// ============================================================================
+
+static const Theme THEMES[] = {
+  #if defined(PBL_COLOR)
+  { .accent = GColorCyan,         .ring = GColorWhite,     .label = GColorDarkGray, .label_active = GColorWhite },
+  { .accent = GColorOrange,       .ring = GColorWhite,     .label = GColorDarkGray, .label_active = GColorOrange },
+  { .accent = GColorGreen,        .ring = GColorLightGray, .label = GColorDarkGray, .label_active = GColorGreen },
+  { .accent = GColorWhite,        .ring = GColorLightGray, .label = GColorDarkGray, .label_active = GColorWhite },
+  #else
+  { .accent = GColorWhite,        .ring = GColorWhite,     .label = GColorWhite,    .label_active = GColorWhite },
+  #endif
+};
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static int s_theme = 0;
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void theme_init(void) {
+  if (!persist_exists(PERSIST_KEY_THEME)) return;
+  int index = persist_read_int(PERSIST_KEY_THEME);
+  if (index >= 0 && index < (int)ARRAY_LENGTH(THEMES)) s_theme = index;
+}
+
+const Theme* theme_get(void) {
+  return &THEMES[s_theme];
+}
+
+void theme_set(int index) {
+  if (index < 0 || index >= (int)ARRAY_LENGTH(THEMES)) return;
+  if (index == s_theme) return;
+  s_theme = index;
+  persist_write_int(PERSIST_KEY_THEME, index);
+  render_invalidate(RenderDepTheme);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <pebble.h>
+
+// Runtime color themes, chosen from a preset table by the THEME message key
+// and persisted across launches. Layers read colors through theme_get();
+// a change is reported to the render scheduler as RenderDepTheme, so each
+// layer decides how cheaply it can follow (the face only rewrites its
+// palette). B&W platforms have a single white theme.
+
+#define PERSIST_KEY_THEME  3
+
+typedef struct {
+  GColor accent;        // center dot, second hand, date, icon highlights
+  GColor ring;          // clock ring and markers
+  GColor label;         // hour numbers
+  GColor label_active;  // the current hour's number (color platforms only)
+} Theme;
+
+// Restores the persisted theme — call before the window is pushed
+void theme_init(void);
+
+// The active theme
+const Theme* theme_get(void);
+
+// Switches to preset index (out-of-range values are ignored) and persists it
+void theme_set(int index);
@@ -5,35 +5,212 @@
 // These are declared extern in watchface.h — defined exactly once here
 // ============================================================================
 
-GPoint s_center;
-int    s_radius;
-int    s_w_radius;
-int    s_h_radius;
-GFont  s_font;
-GFont  date_font;
-int    s_num_offset;
+WatchfaceContext s_watchface;
+
+#if defined(WATCHFACE_GEOMETRY_TABLES)
+  #include "watchface_geometry_table.h"  // generated by wscript for this platform
+
+const FaceGeometry   *s_face_geometry_ref   = &s_face_geometry_table;
+const HandsGeometry  *s_hands_geometry_ref  = &s_hands_geometry_table;
+const WidgetGeometry *s_widget_geometry_ref = &s_widget_geometry_table;
+
+// Runtime copies, allocated the first time the bounds differ from the tables'
+typedef struct {
+  FaceGeometry   face;
+  HandsGeometry  hands;
+  WidgetGeometry widget;
+} RuntimeGeometry;
+
+static RuntimeGeometry *s_runtime = NULL;
+#else
+FaceGeometry   s_face_geometry;
+HandsGeometry  s_hands_geometry;
+WidgetGeometry s_widget_geometry;
+#endif
+
+// ============================================================================
+// GEOMETRY CACHE — built at runtime when no generated table header exists,
+// or when the bounds are not the screen the tables were generated for.
+// tools/geometry_tables.py mirrors this math; keep the two in sync.
+// ============================================================================
+
+static int s_num_offset;  // proportional gap from tick inner end to number center
+
+// Fills face from the current center/radii. Runs the full get_point_on_face
+// path 132 times here instead of on every frame.
+static void build_face_geometry(FaceGeometry *face) {
+  int face_w = FACE_W_RADIUS - (CLOCK_FACE_STROKE_WIDTH / 2);
+  int face_h = FACE_H_RADIUS - (CLOCK_FACE_STROKE_WIDTH / 2);
+  int offset = MAJOR_MARKER_LENGTH + s_num_offset;
+
+  for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+    int32_t angle = degrees_to_trig_angle(i * 6);
+    int     len   = is_major_marker(i) ? MAJOR_MARKER_LENGTH : MINOR_MARKER_LENGTH;
+
+    face->marker_outer[i] = get_point_on_face(angle, face_w, face_h);
+    face->marker_inner[i] = get_point_on_face(angle, face_w - len, face_h - len);
+
+    if (is_major_marker(i)) {
+      GPoint pos = get_point_on_face(angle, face_w - offset, face_h - offset);
+      face->label_rect[i / MAJOR_MARKER_INTERVAL] = GRect(
+        pos.x - HOUR_LABEL_SIZE / 2, pos.y - HOUR_LABEL_SIZE / 2,
+        HOUR_LABEL_SIZE, HOUR_LABEL_SIZE
+      );
+    }
+  }
+}
+
+// Fills hands. Lengths are integer percentages of s_watchface.radius so no
+// soft-float code is pulled in; the trig runs here once, never per frame.
+static void build_hands_geometry(HandsGeometry *hands) {
+  int hour_len   = s_watchface.radius * HOUR_HAND_LENGTH_PCT / 100;
+  int hour_inner = hour_len - (HOUR_HAND_WIDTH / 2) + 1;
+  int minute_len = s_watchface.radius * MINUTE_HAND_LENGTH_PCT / 100;
+  int second_len = s_watchface.radius * SECOND_HAND_LENGTH_PCT / 100;
+  int tail_len   = s_watchface.radius * SECOND_HAND_TAIL_PCT / 100;
+
+  for (int d = 0; d < HOUR_HAND_POSITIONS; d++) {
+    int32_t angle = degrees_to_trig_angle(d);
+    hands->hour_end[d]   = get_point_on_circle(angle, hour_len);
+    hands->hour_inner[d] = get_point_on_circle(angle, hour_inner);
+  }
+
+  for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+    int32_t angle = degrees_to_trig_angle(i * 6);
+    hands->minute_end[i]   = get_point_on_circle(angle, minute_len);
+    hands->second_end[i]   = get_point_on_circle(angle, second_len);
+    hands->second_start[i] = get_point_on_circle(revert_angle(angle), tail_len);
+  }
+
+  #if defined(WATCHFACE_SMOOTH_SECONDS)
+  for (int p = 0; p < SWEEP_HAND_POSITIONS; p++) {
+    int32_t angle = degrees_to_trig_angle(p * 360 / SWEEP_HAND_POSITIONS);
+    hands->sweep_end[p]   = get_point_on_circle(angle, second_len);
+    hands->sweep_start[p] = get_point_on_circle(revert_angle(angle), tail_len);
+  }
+  #endif
+}
+
+// Fills widget from the label positions the face uses
+static void build_widget_geometry(WidgetGeometry *widget, GRect bounds) {
+  int face_h_edge = FACE_H_RADIUS - (CLOCK_FACE_STROKE_WIDTH / 2);
+  int num_offset  = MAJOR_MARKER_LENGTH + s_num_offset;
+
+  // Weather sits just below the "12" label, inside the clock face interior —
+  // no overlap with ring, markers, or hour numbers
+  int label_bottom = s_watchface.center.y - (face_h_edge - num_offset) + HOUR_LABEL_SIZE / 2;
+  widget->weather_frame = GRect(
+    0, label_bottom + WEATHER_LABEL_GAP, bounds.size.w, WEATHER_LAYER_HEIGHT
+  );
+
+  // Date is centered vertically between the center dot and the "6" label
+  int six_top    = s_watchface.center.y + (face_h_edge - num_offset) - HOUR_LABEL_SIZE / 2;
+  int dot_bottom = s_watchface.center.y + CENTER_DOT_RADIUS;
+  int mid_y      = (dot_bottom + six_top) / 2;
+  widget->date_rect = GRect(
+    s_watchface.center.x - DATE_WIDGET_WIDTH / 2, mid_y - DATE_WIDGET_HEIGHT / 2,
+    DATE_WIDGET_WIDTH, DATE_WIDGET_HEIGHT
+  );
+}
+
+static void build_geometry(FaceGeometry *face, HandsGeometry *hands, WidgetGeometry *widget,
+                           GRect bounds) {
+  // Proportional gap from tick inner end to number center.
+  // Keep the original 20px on large screens (emery radius≈98, gabbro≈128);
+  // scale down on smaller platforms so numbers sit visually closer to their ticks.
+  s_num_offset = (s_watchface.radius > 90) ? NUMBER_OFFSET_FROM_MARKER : (s_watchface.radius / 5);
+
+  build_face_geometry(face);
+  build_hands_geometry(hands);
+  build_widget_geometry(widget, bounds);
+}
+
+#if defined(WATCHFACE_GEOMETRY_TABLES)
+// Points the caches at the tables, or at a runtime build for other bounds.
+// If there is no heap for it the tables stay, drawn off-center
+static void select_geometry(GRect bounds) {
+  if (bounds.size.w == GEOMETRY_TABLE_WIDTH && bounds.size.h == GEOMETRY_TABLE_HEIGHT) {
+    s_face_geometry_ref   = &s_face_geometry_table;
+    s_hands_geometry_ref  = &s_hands_geometry_table;
+    s_widget_geometry_ref = &s_widget_geometry_table;
+    if (s_runtime) {
+      free(s_runtime);
+      s_runtime = NULL;
+    }
+    return;
+  }
+
+  if (!s_runtime) s_runtime = malloc(sizeof(RuntimeGeometry));
+  if (!s_runtime) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Geometry tables are for %dx%d, no heap to build %dx%d",
+            GEOMETRY_TABLE_WIDTH, GEOMETRY_TABLE_HEIGHT, bounds.size.w, bounds.size.h);
+    return;
+  }
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Geometry tables are for %dx%d, building %dx%d",
+          GEOMETRY_TABLE_WIDTH, GEOMETRY_TABLE_HEIGHT, bounds.size.w, bounds.size.h);
+  build_geometry(&s_runtime->face, &s_runtime->hands, &s_runtime->widget, bounds);
+  s_face_geometry_ref   = &s_runtime->face;
+  s_hands_geometry_ref  = &s_runtime->hands;
+  s_widget_geometry_ref = &s_runtime->widget;
+}
+#endif
 
 // ============================================================================
 // GEOMETRY INIT 
 // ============================================================================
 
 void watchface_geometry_init(GRect bounds) {
-  s_center   = grect_center_point(&bounds);
-  s_w_radius = (bounds.size.w / 2) - 2;
-  s_h_radius = (bounds.size.h / 2) - 2;
-  s_radius   = (s_w_radius < s_h_radius) ? s_w_radius : s_h_radius;
+  int w_radius = (bounds.size.w / 2) - 2;
+  int h_radius = (bounds.size.h / 2) - 2;
+  s_watchface.center = grect_center_point(&bounds);
+  s_watchface.radius = (w_radius < h_radius) ? w_radius : h_radius;
+  #if defined(PBL_RECT)
+  s_watchface.w_radius = w_radius;
+  s_watchface.h_radius = h_radius;
+  #endif
 
   // Large screens (emery 200, gabbro 260) use the bigger number font;
   // smaller screens (basalt/aplite/diorite/flint 144, chalk 180) use LECO_20.
-  s_font = (bounds.size.w > 195)
+  s_watchface.hour_font = (bounds.size.w > 195)
     ? fonts_get_system_font(FONT_KEY_LECO_26_BOLD_NUMBERS_AM_PM)
     : fonts_get_system_font(FONT_KEY_LECO_20_BOLD_NUMBERS);
-  date_font = fonts_get_system_font(FONT_KEY_LECO_20_BOLD_NUMBERS);
+  s_watchface.text_font = fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD);
 
-  // Proportional gap from tick inner end to number center.
-  // Keep the original 20px on large screens (emery s_radius≈98, gabbro≈128);
-  // scale down on smaller platforms so numbers sit visually closer to their ticks.
-  s_num_offset = (s_radius > 90) ? NUMBER_OFFSET_FROM_MARKER : (s_radius / 5);
+  #if defined(WATCHFACE_GEOMETRY_TABLES)
+  // Tables are const for the full screen; nothing to build there
+  select_geometry(bounds);
+  #else
+  build_geometry(&s_face_geometry, &s_hands_geometry, &s_widget_geometry, bounds);
+  #endif
+}
+
+// Slides rect vertically into top..bottom. Moving toward the center is
+// only allowed while the rect stays WIDGET_CENTER_CLEARANCE away from it,
+// so a squeezed widget never lands on the dot or the hub of the hands
+static GRect fit_rect(GRect rect, int top, int bottom) {
+  int y = rect.origin.y;
+  int h = rect.size.h;
+  if (y < top)        y = top;
+  if (y + h > bottom) y = bottom - h;
+  if (y < top) return GRectZero;  // taller than the area
+
+  int center_y = s_watchface.center.y;
+  if (rect.origin.y + h / 2 < center_y) {
+    if (y > rect.origin.y && y + h > center_y - WIDGET_CENTER_CLEARANCE) return GRectZero;
+  } else {
+    if (y < rect.origin.y && y < center_y + WIDGET_CENTER_CLEARANCE) return GRectZero;
+  }
+  rect.origin.y = y;
+  return rect;
+}
+
+WidgetGeometry watchface_fit_widgets(GRect area) {
+  int top    = area.origin.y;
+  int bottom = area.origin.y + area.size.h;
+  return (WidgetGeometry) {
+    .weather_frame = fit_rect(s_widget_geometry.weather_frame, top, bottom),
+    .date_rect     = fit_rect(s_widget_geometry.date_rect,     top, bottom),
+  };
 }
 
 // ============================================================================
@@ -50,21 +227,27 @@ int32_t revert_angle(int32_t angle) {
 
 GPoint get_point_on_circle(int32_t angle, int distance_from_center) {
   return (GPoint) {
-    .x = s_center.x + (int)(sin_lookup(angle) * distance_from_center / TRIG_MAX_RATIO),
-    .y = s_center.y - (int)(cos_lookup(angle) * distance_from_center / TRIG_MAX_RATIO)
+    .x = s_watchface.center.x + (int)(sin_lookup(angle) * distance_from_center / TRIG_MAX_RATIO),
+    .y = s_watchface.center.y - (int)(cos_lookup(angle) * distance_from_center / TRIG_MAX_RATIO)
   };
 }
 
-static int64_t isqrt(int64_t n) {
-  if (n < 0) return 0;
-  if (n == 0) return 0;
-  int64_t x = n;
-  int64_t y = (x + 1) / 2;
-  while (y < x) {
-    x = y;
-    y = (x + n / x) / 2;
+// Digit by digit, two bits of n per step. The remainder never exceeds
+// 2 * root, so for n below 2^58 it and the root stay in 32 bits, and there
+// is no division at all
+uint32_t isqrt(uint64_t n) {
+  uint32_t root = 0;
+  uint32_t rem  = 0;
+  for (int shift = 56; shift >= 0; shift -= 2) {
+    rem    = (rem << 2) | (uint32_t)((n >> shift) & 3);
+    root <<= 1;
+    uint32_t trial = (root << 1) | 1;
+    if (rem >= trial) {
+      rem  -= trial;
+      root |= 1;
+    }
   }
-  return x;
+  return root;
 }
 
 GPoint get_point_on_rounded_rect(int32_t angle, int w_radius, int h_radius, int corner_radius) {
@@ -91,29 +274,33 @@ GPoint get_point_on_rounded_rect(int32_t angle, int w_radius, int h_radius, int
 
   if (!in_corner) {
     return (GPoint) {
-      .x = s_center.x + px,
-      .y = s_center.y + py
+      .x = s_watchface.center.x + px,
+      .y = s_watchface.center.y + py
     };
   }
 
+  // Ray from the center meets the corner arc at t = dot + sqrt(r^2 - cross^2),
+  // everything in TRIG_MAX_RATIO fixed point. Screen-sized radii keep dot,
+  // cross and r in 32 bits; only r^2 - cross^2, taken as (r - |cross|) *
+  // (r + |cross|), needs the 64-bit product of two 32-bit values
   int arc_cx = (sin_val > 0) ?  cx : -cx;
   int arc_cy = (cos_val > 0) ? -cy :  cy;
 
-  int64_t dot   = (int64_t)arc_cx * sin_val + (int64_t)arc_cy * (-cos_val);
-  int64_t cross = (int64_t)arc_cx * (-cos_val) - (int64_t)arc_cy * sin_val;
-
-  int64_t r_trig    = (int64_t)corner_radius * TRIG_MAX_RATIO;
-  int64_t discriminant = r_trig * r_trig - cross * cross;
-
-  if (discriminant < 0) discriminant = 0;
+  int32_t  dot       = arc_cx * sin_val - arc_cy * cos_val;
+  int32_t  cross     = -arc_cx * cos_val - arc_cy * sin_val;
+  uint32_t abs_cross = cross > 0 ? cross : -cross;
+  uint32_t r_trig    = (uint32_t)corner_radius * TRIG_MAX_RATIO;
 
-  int64_t sqrt_disc = isqrt(discriminant);
+  uint32_t sqrt_disc = 0;
+  if (abs_cross < r_trig) {
+    sqrt_disc = isqrt((uint64_t)(r_trig - abs_cross) * (r_trig + abs_cross));
+  }
 
-  int64_t t = (dot + sqrt_disc) / TRIG_MAX_RATIO;
+  int32_t t = (dot + (int32_t)sqrt_disc) / TRIG_MAX_RATIO;
 
   return (GPoint) {
-    .x = s_center.x + (int)(sin_val * t / TRIG_MAX_RATIO),
-    .y = s_center.y - (int)(cos_val * t / TRIG_MAX_RATIO)
+    .x = s_watchface.center.x + (int)(sin_val * t / TRIG_MAX_RATIO),
+    .y = s_watchface.center.y - (int)(cos_val * t / TRIG_MAX_RATIO)
   };
 }
 
@@ -129,8 +316,8 @@ GPoint get_point_on_rect(int32_t angle, int w_radius, int h_radius) {
     scale = (int32_t)h_radius * TRIG_MAX_RATIO / abs_cos;
   }
   return (GPoint) {
-    .x = s_center.x + (int)(sin_val * scale / TRIG_MAX_RATIO),
-    .y = s_center.y - (int)(cos_val * scale / TRIG_MAX_RATIO)
+    .x = s_watchface.center.x + (int)(sin_val * scale / TRIG_MAX_RATIO),
+    .y = s_watchface.center.y - (int)(cos_val * scale / TRIG_MAX_RATIO)
   };
 }
 
@@ -142,5 +329,30 @@ GPoint get_point_on_face(int32_t angle, int w_dist, int h_dist) {
   #endif
 }
 
+// ============================================================================
+// CLOCK
+// ============================================================================
+
+#if defined(WATCHFACE_SCENARIO)
+static int32_t s_time_offset = 0;
+
+void watchface_set_time_offset(int32_t seconds) {
+  s_time_offset = seconds;
+}
+#endif
+
+time_t watchface_time(void) {
+  time_t now = time(NULL);
+  #if defined(WATCHFACE_SCENARIO)
+  now += s_time_offset;
+  #endif
+  return now;
+}
+
+struct tm *watchface_localtime(void) {
+  time_t now = watchface_time();
+  return localtime(&now);
+}
+
 bool is_major_marker(int index) { return (index % MAJOR_MARKER_INTERVAL) == 0; }
 int  get_display_hour(int index) { return (index == 0) ? 12 : index / 5; }
\ No newline at end of file
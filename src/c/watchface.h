@@ -15,50 +15,179 @@
 #define NUMBER_OFFSET_FROM_MARKER  20
 #define DATE_OFFSET_FROM_CENTER    40
 #define SQR_WATCHFACE_RADIOUS      30
+#define HOUR_LABEL_COUNT           12
+#define HOUR_LABEL_SIZE            32
+#define WEATHER_LABEL_GAP          6   // gap between the "12" label and the weather widget
+#define WEATHER_LAYER_HEIGHT       30
+#define DATE_WIDGET_WIDTH          80
+#define DATE_WIDGET_HEIGHT         24
+#define WIDGET_CENTER_CLEARANCE    13  // center dot + half the hour hand: the hub every hand covers
 
-#define HOUR_HAND_LENGTH_RATIO     0.50f
-#define MINUTE_HAND_LENGTH_RATIO   0.85f
+// Hand lengths as integer percentages of s_watchface.radius — no float on FPU-less platforms
+#define HOUR_HAND_LENGTH_PCT       50
+#define MINUTE_HAND_LENGTH_PCT     85
 
 #define HOUR_HAND_WIDTH           14
 #define MINUTE_HAND_WIDTH          6
 #define CENTER_DOT_RADIUS          6
+#define GMT_HAND_WIDTH             3   // second-zone hand (second_tz.h)
+#define GMT_TIP_RADIUS             3   // its AM/PM cue: ring = AM, dot = PM
 
 // Seconds hand — only shown on shake
-#define SECOND_HAND_LENGTH_RATIO  0.85f
+#define SECOND_HAND_LENGTH_PCT    85
+#define SECOND_HAND_TAIL_PCT      20   // counterweight behind the center
 #define SECOND_HAND_WIDTH         2
 #define SECONDS_DISPLAY_DURATION  10000  // milliseconds (10 seconds)
 
-#define HOUR_NUMBER_INACTIVE_COLOR  PBL_IF_COLOR_ELSE(GColorDarkGray, GColorDarkGray)
-#define HOUR_NUMBER_ACTIVE_COLOR    GColorWhite
-#define WATCHFACE_THEME_COLOR       GColorCyan
+// Rasterize the static face (ring + markers + numbers) once into an offscreen
+// bitmap and blit it on every frame. Set to 0 to draw primitives every frame.
+#define FACE_CACHE_ENABLED        1
+
+// Fill each hand as one rotated GPath instead of stroking thick lines. Off
+// by default: the GPath hands look different (chamfered tips, U-shaped hour
+// outline, a filled center dot instead of a stroked ring), so the original
+// two-pass line renderer stays until that look is signed off.
+// WATCHFACE_GPATH_HANDS=1 turns it on (tools/host_render.py builds both to
+// compare them).
+#ifndef HANDS_USE_GPATH
+#if defined(WATCHFACE_GPATH_HANDS)
+#define HANDS_USE_GPATH           1
+#else
+#define HANDS_USE_GPATH           0
+#endif
+#endif
+
+// Colors come from the runtime theme — see theme.h
 
 // ============================================================================
-// SHARED GEOMETRY STATE — owned by watchface.c, read by all modules
+// SHARED CONTEXT — owned by watchface.c, read by all modules
 // ============================================================================
 
-// These are extern so all modules can read cached geometry
-// without recomputing or passing parameters everywhere
-extern GPoint s_center;
-extern int    s_radius;
-extern int    s_w_radius;
-extern int    s_h_radius;
-extern GFont  s_font;
-extern GFont  date_font;
-extern int    s_num_offset;  // proportional gap from tick inner end to number center
+// Everything the modules share besides the geometry tables, filled once by
+// watchface_geometry_init. Pointers first, then the 16-bit fields, so the
+// struct has no interior padding. Round faces have one radius, so the w/h
+// pair only exists on rect platforms — read it through FACE_W/H_RADIUS
+typedef struct {
+  GFont   hour_font;  // hour labels, sized for the screen
+  GFont   text_font;  // date and weather text
+  GPoint  center;
+  int16_t radius;     // largest circle that fits the screen
+  #if defined(PBL_RECT)
+  int16_t w_radius;   // half-extents of the rounded-rect face
+  int16_t h_radius;
+  #endif
+} WatchfaceContext;
+
+extern WatchfaceContext s_watchface;
+
+#if defined(PBL_ROUND)
+  #define FACE_W_RADIUS  (s_watchface.radius)
+  #define FACE_H_RADIUS  (s_watchface.radius)
+#else
+  #define FACE_W_RADIUS  (s_watchface.w_radius)
+  #define FACE_H_RADIUS  (s_watchface.h_radius)
+#endif
+
+// Geometry caches below are filled by watchface_geometry_init, or — when the
+// build generated a table header for this platform — are const data in flash
+// and never computed at all (see tools/geometry_tables.py). With tables, each
+// name reads through a pointer that watchface_geometry_init switches to a
+// heap copy built at runtime while the bounds are not the tables' screen.
+
+// Face geometry cache — every marker endpoint and hour-label rect, so
+// drawing never touches the trig path
+typedef struct {
+  GPoint marker_outer[MINUTE_MARKER_COUNT];
+  GPoint marker_inner[MINUTE_MARKER_COUNT];
+  GRect  label_rect[HOUR_LABEL_COUNT];  // index 0 is the "12" label
+} FaceGeometry;
+
+#if defined(WATCHFACE_GEOMETRY_TABLES)
+  extern const FaceGeometry *s_face_geometry_ref;
+  #define s_face_geometry (*s_face_geometry_ref)
+#else
+  extern FaceGeometry s_face_geometry;
+#endif
+
+// Hands geometry cache — hand endpoints for every reachable position.
+// The hour hand moves in whole degrees ((tm_hour % 12) * 30 + tm_min / 2),
+// so its 720 minute positions collapse to 360 distinct entries.
+#define HOUR_HAND_POSITIONS  360
+
+// The smooth-sweep second hand (WATCHFACE_SMOOTH_SECONDS) reads one of 360
+// positions too, a degree (1/6 s) apart, instead of doing trig every step
+#define SWEEP_HAND_POSITIONS 360
+
+typedef struct {
+  GPoint hour_end[HOUR_HAND_POSITIONS];
+  GPoint hour_inner[HOUR_HAND_POSITIONS];  // end of the black inner pass
+  GPoint minute_end[MINUTE_MARKER_COUNT];
+  GPoint second_start[MINUTE_MARKER_COUNT];  // tail, opposite the tip
+  GPoint second_end[MINUTE_MARKER_COUNT];
+  #if defined(WATCHFACE_SMOOTH_SECONDS)
+  GPoint sweep_start[SWEEP_HAND_POSITIONS];  // same hand at sub-second steps
+  GPoint sweep_end[SWEEP_HAND_POSITIONS];
+  #endif
+} HandsGeometry;
+
+#if defined(WATCHFACE_GEOMETRY_TABLES)
+  extern const HandsGeometry *s_hands_geometry_ref;
+  #define s_hands_geometry (*s_hands_geometry_ref)
+#else
+  extern HandsGeometry s_hands_geometry;
+#endif
+
+// Widget rects in window coordinates
+typedef struct {
+  GRect weather_frame;  // weather layer, just below the "12" label
+  GRect date_rect;      // date text, between the center dot and the "6" label
+} WidgetGeometry;
+
+#if defined(WATCHFACE_GEOMETRY_TABLES)
+  extern const WidgetGeometry *s_widget_geometry_ref;
+  #define s_widget_geometry (*s_widget_geometry_ref)
+#else
+  extern WidgetGeometry s_widget_geometry;
+#endif
 
 // ============================================================================
 // GEOMETRY API
 // ============================================================================
 
-// Call once at window load to cache all shared geometry
+// Call at window load to cache all shared geometry. Call again whenever the
+// bounds change to rebuild the geometry cache.
+// Generated const tables only describe the full screen: other bounds are
+// built at runtime into the heap, and the tables come back with the full
+// screen.
 void watchface_geometry_init(GRect bounds);
 
+// Widget rects for a face of which only area (container coordinates) is
+// visible, e.g. above a timeline peek. A widget cut by the edge of area
+// slides back inside it, but not toward the center past
+// WIDGET_CENTER_CLEARANCE; one that cannot fit gets GRectZero. Plain
+// arithmetic on s_widget_geometry, cheap enough for every animation step.
+WidgetGeometry watchface_fit_widgets(GRect area);
+
 int32_t degrees_to_trig_angle(int degrees);
 int32_t revert_angle(int32_t angle);
 
 GPoint get_point_on_circle(int32_t angle, int distance_from_center);
 GPoint get_point_on_rect(int32_t angle, int w_radius, int h_radius);
+GPoint get_point_on_rounded_rect(int32_t angle, int w_radius, int h_radius, int corner_radius);
 GPoint  get_point_on_face(int32_t angle, int w_dist, int h_dist);
 
+// floor(sqrt(n)) for n < 2^58, shifts and adds only (see watchface.c)
+uint32_t isqrt(uint64_t n);
+
+// Current time (UTC seconds) and local time. Modules read the clock through
+// these so the scripted benchmark scenario (scenario.c) can run them on a
+// simulated clock.
+time_t     watchface_time(void);
+struct tm *watchface_localtime(void);
+
+#if defined(WATCHFACE_SCENARIO)
+void watchface_set_time_offset(int32_t seconds);
+#endif
+
 bool is_major_marker(int index);
 int  get_display_hour(int index);
\ No newline at end of file
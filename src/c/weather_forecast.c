@@ -0,0 +1,123 @@
+#include "weather_forecast.h"
+#include "sparkline.h"
+
+// ============================================================================
+// PRIVATE CONSTANTS
+// ============================================================================
+
+#define PERSIST_KEY_FORECAST  2
+#define SECONDS_PER_HOUR      3600
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static uint8_t s_packed[WEATHER_PACKED_MAX];  // last valid payload, as received
+static int     s_packed_len = 0;
+static time_t  s_start      = 0;
+static int     s_count      = 0;
+static int8_t  s_temps[WEATHER_FORECAST_MAX];
+static uint8_t s_icons[WEATHER_FORECAST_MAX];
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+static uint8_t read_icon_bits(const uint8_t *bits, int i) {
+  int bit   = i * 3;
+  int value = bits[bit / 8] >> (bit % 8);
+  if (bit % 8 > 5) value |= bits[bit / 8 + 1] << (8 - bit % 8);
+  return value & 0x07;
+}
+
+// Validates and unpacks data into the forecast arrays
+static bool unpack(const uint8_t *data, uint16_t length) {
+  if (length < WEATHER_PACKED_HEADER || length > WEATHER_PACKED_MAX) return false;
+  if (data[0] != WEATHER_PACKED_VERSION) return false;
+
+  int count = data[1];
+  if (count > WEATHER_FORECAST_MAX) return false;
+  if (length != WEATHER_PACKED_HEADER + count + (count * 3 + 7) / 8) return false;
+
+  s_start = (time_t)((uint32_t)data[2] | ((uint32_t)data[3] << 8) |
+                     ((uint32_t)data[4] << 16) | ((uint32_t)data[5] << 24));
+  s_count = count;
+
+  const uint8_t *temps = data + WEATHER_PACKED_HEADER;
+  const uint8_t *icons = temps + count;
+  for (int i = 0; i < count; i++) {
+    s_temps[i] = (int8_t)temps[i];
+    s_icons[i] = read_icon_bits(icons, i);
+  }
+
+  memcpy(s_packed, data, length);
+  s_packed_len = length;
+  return true;
+}
+
+static int current_index(time_t now) {
+  if (s_count == 0 || now < s_start) return -1;
+  int index = (now - s_start) / SECONDS_PER_HOUR;
+  return (index < s_count) ? index : -1;
+}
+
+// Hours since entry 0, which may run past the end of the batch
+static int hours_elapsed(time_t now) {
+  return (now < s_start) ? 0 : (now - s_start) / SECONDS_PER_HOUR;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void weather_forecast_init(void) {
+  uint8_t data[WEATHER_PACKED_MAX];
+  int length = persist_read_data(PERSIST_KEY_FORECAST, data, sizeof(data));
+  if (length <= 0 || !unpack(data, length)) return;
+  sparkline_set(s_temps, s_count, hours_elapsed(time(NULL)));
+
+  // Relaunched in a later hour than the stored reading — roll forward now
+  time_t now   = time(NULL);
+  int    index = current_index(now);
+  if (index >= 0 && weather_layer_get_updated_at() < s_start + index * SECONDS_PER_HOUR) {
+    weather_forecast_advance();
+  }
+}
+
+bool weather_forecast_set_packed(const uint8_t *data, uint16_t length) {
+  if (!unpack(data, length)) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Malformed weather payload (%u bytes)", length);
+    return false;
+  }
+  persist_write_data(PERSIST_KEY_FORECAST, s_packed, s_packed_len);
+  sparkline_set(s_temps, s_count, hours_elapsed(time(NULL)));
+  weather_layer_set_data((int8_t)data[6], (WeatherIconType)(data[7] & 0x07));
+  return true;
+}
+
+void weather_forecast_advance(void) {
+  time_t now = time(NULL);
+  sparkline_advance(s_temps, s_count, hours_elapsed(now));
+  int index = current_index(now);
+  if (index < 0) return;
+  weather_layer_show_forecast(s_temps[index], (WeatherIconType)s_icons[index]);
+}
+
+bool weather_forecast_covers(time_t now) {
+  return current_index(now) >= 0;
+}
+
+bool weather_forecast_get(int i, int *temp_c, WeatherIconType *icon) {
+  if (i < 0 || i >= s_count) return false;
+  if (temp_c) *temp_c = s_temps[i];
+  if (icon)   *icon   = (WeatherIconType)s_icons[i];
+  return true;
+}
+
+int weather_forecast_count(void) {
+  return s_count;
+}
+
+time_t weather_forecast_start_time(void) {
+  return s_start;
+}
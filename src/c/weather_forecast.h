@@ -0,0 +1,42 @@
+#pragma once
+#include <pebble.h>
+#include "layer_weather.h"
+
+// Hourly forecast batch delivered in one WEATHER_PACKED byte array, so the
+// watch can roll to the next hour's conditions locally with no radio traffic.
+//
+// Packed layout (little-endian), 8 + N + ceil(3N / 8) bytes:
+//   [0]      version (WEATHER_PACKED_VERSION)
+//   [1]      N — number of hourly entries (<= WEATHER_FORECAST_MAX)
+//   [2..5]   uint32 unix time of the hour entry 0 starts at
+//   [6]      int8  current temperature, Celsius
+//   [7]      uint8 current icon (WeatherIconType)
+//   [8..]    N x int8 hourly temperatures
+//   [..]     N x 3-bit hourly icons, packed LSB-first
+
+#define WEATHER_PACKED_VERSION  1
+#define WEATHER_FORECAST_MAX    12
+#define WEATHER_PACKED_HEADER   8
+#define WEATHER_PACKED_MAX      (WEATHER_PACKED_HEADER + WEATHER_FORECAST_MAX + \
+                                 (WEATHER_FORECAST_MAX * 3 + 7) / 8)
+
+// Restores the last forecast from persistent storage. Call from init
+void weather_forecast_init(void);
+
+// Parses and stores a packed payload and shows its current conditions.
+// Returns false (and changes nothing) if the payload is malformed.
+bool weather_forecast_set_packed(const uint8_t *data, uint16_t length);
+
+// Shows the forecast entry for the current hour, if there is one. The last
+// received reading keeps its time and stays the persisted one.
+// Call from tick_handler when HOUR_UNIT changed
+void weather_forecast_advance(void);
+
+// True if the stored forecast has an entry for the hour containing now
+bool weather_forecast_covers(time_t now);
+
+// Forecast entry i (0 = the hour starting at weather_forecast_start_time).
+// Returns false if i is out of range
+bool weather_forecast_get(int i, int *temp_c, WeatherIconType *icon);
+int    weather_forecast_count(void);
+time_t weather_forecast_start_time(void);
@@ -0,0 +1,109 @@
+#include "weather_refresh.h"
+#include "layer_weather.h"
+#include "weather_forecast.h"
+#include "power_governor.h"
+#include "battery_policy.h"
+#include "profile.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+static bool   s_pending       = false;  // request sent, no data yet
+static bool   s_held_back     = false;  // due request waiting for the phone
+static time_t s_sent_at       = 0;
+static time_t s_next_attempt  = 0;      // earliest time the next request may go out
+static int    s_backoff_min   = WEATHER_RETRY_INITIAL_MIN;
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+static void register_success(void) {
+  s_pending      = false;
+  s_next_attempt = 0;
+  s_backoff_min  = WEATHER_RETRY_INITIAL_MIN;
+}
+
+static void register_failure(time_t now) {
+  s_pending      = false;
+  s_next_attempt = now + s_backoff_min * 60;
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Weather refresh failed, retrying in %d min", s_backoff_min);
+
+  s_backoff_min *= 2;
+  if (s_backoff_min > WEATHER_RETRY_MAX_MIN) s_backoff_min = WEATHER_RETRY_MAX_MIN;
+}
+
+static void send_request(time_t now) {
+  DictionaryIterator *iter;
+  AppMessageResult result = app_message_outbox_begin(&iter);
+  if (result != APP_MSG_OK) {
+    profile_outbox_result(result);
+    register_failure(now);
+    return;
+  }
+  dict_write_uint8(iter, MESSAGE_KEY_dummy, 1);
+  result = app_message_outbox_send();
+  if (result != APP_MSG_OK) {
+    profile_outbox_result(result);
+    register_failure(now);
+    return;
+  }
+  s_pending = true;
+  s_sent_at = now;
+}
+
+// ============================================================================
+// PRIVATE: SERVICE CALLBACKS
+// ============================================================================
+
+static void outbox_sent_callback(DictionaryIterator *iter, void *context) {
+  profile_outbox_result(APP_MSG_OK);
+}
+
+static void outbox_failed_callback(DictionaryIterator *iter, AppMessageResult reason, void *context) {
+  profile_outbox_result(reason);
+  if (s_pending) register_failure(time(NULL));
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void weather_refresh_init(void) {
+  app_message_register_outbox_sent(outbox_sent_callback);
+  app_message_register_outbox_failed(outbox_failed_callback);
+}
+
+uint32_t weather_refresh_outbox_size(void) {
+  return dict_calc_buffer_size(1, sizeof(uint8_t));
+}
+
+void weather_refresh_tick(void) {
+  time_t now        = time(NULL);
+  time_t updated_at = weather_layer_get_updated_at();
+
+  if (s_pending) {
+    if (updated_at >= s_sent_at) {
+      register_success();
+    } else if (now - s_sent_at >= WEATHER_RESPONSE_TIMEOUT_S) {
+      register_failure(now);
+    } else {
+      return;  // still waiting for the answer
+    }
+  }
+
+  if (power_governor_is_low()) return;  // nobody is looking; refresh on wake
+  if (now < s_next_attempt) return;
+  if (updated_at != 0 && now - updated_at < WEATHER_REFRESH_BUDGET_MIN * 60) return;
+  if (weather_forecast_covers(now)) return;  // next hours roll over locally
+
+  // Due, but the phone is out of reach — retried every minute, counted once
+  if (!battery_policy_connected()) {
+    if (!s_held_back) battery_policy_skipped_refresh();
+    s_held_back = true;
+    return;
+  }
+  s_held_back = false;
+  send_request(now);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <pebble.h>
+
+// Watch-driven weather refresh. When the displayed reading is older than
+// WEATHER_REFRESH_BUDGET_MIN and the stored forecast doesn't cover the
+// current hour, a request (the "dummy" key) is sent to
+// PebbleKit JS. Failed or unanswered requests back off exponentially, and
+// nothing is sent while the phone is disconnected (battery_policy.h) or the
+// power governor is in low power — so radio use stays bounded no matter how
+// long the face runs.
+
+#define WEATHER_REFRESH_BUDGET_MIN    30   // max age before a refresh is requested
+#define WEATHER_RETRY_INITIAL_MIN     1    // first retry delay after a failure
+#define WEATHER_RETRY_MAX_MIN         120  // backoff cap
+#define WEATHER_RESPONSE_TIMEOUT_S    90   // no data by then counts as a failure
+
+// Subscribes to outbox results. Call from init after the AppMessage inbox
+// handler is registered.
+void weather_refresh_init(void);
+
+// Outbox bytes needed for a refresh request — pass to app_message_open
+uint32_t weather_refresh_outbox_size(void);
+
+// Checks staleness, pending requests and backoff. Call from tick_handler
+void weather_refresh_tick(void);
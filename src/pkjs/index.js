@@ -1,12 +1,69 @@
 /**
  * PebbleKit JS — Weather fetcher for simple-watchface
  * API: Open-Meteo (free, no key required)
- * Sends: TEMPERATURE (int, Celsius) + WEATHER_ICON (int, 0-7)
+ * Sends: WEATHER_PACKED (byte array: current conditions + hourly forecast),
+ *        THEME (color preset index) and SECOND_TZ (GMT hand offset, minutes
+ *        east of UTC), both set on the configuration page,
+ *        SENT_AT on every message (send time for the watch's latency counters)
+ * Receives: dummy — refresh request sent by the watch when its data is stale
  */
 
+// The watch persists the last reading it received, so a relaunch within this
+// window shows fresh data without a GPS fix or HTTP round trip.
+var WEATHER_FRESH_MS = 30 * 60 * 1000;
+var SENT_AT_KEY = 'weatherSentAt';
+
+// Hourly entries in each WEATHER_PACKED batch — must not exceed
+// WEATHER_FORECAST_MAX in src/c/weather_forecast.h
+var FORECAST_HOURS = 12;
+var PACKED_VERSION = 1;
+
+// Open-Meteo responses are cached in localStorage per grid cell of
+// CACHE_GRID_DEG degrees. A cached response is reused while it is younger
+// than CACHE_TTL_MS and the phone is within CACHE_MAX_MOVE_KM of where it
+// was fetched, so most triggers cost neither an HTTP call nor much radio.
+var CACHE_PREFIX = 'weatherCache:';
+var CACHE_GRID_DEG = 0.05;
+var CACHE_TTL_MS = 30 * 60 * 1000;
+var CACHE_MAX_MOVE_KM = 2;
+
+var XHR_TIMEOUT_MS = 20000;
+
+// Settings from the configuration page, stored as strings. The watch
+// persists what it receives, so each one is only sent when it changes.
+//   theme     index into THEMES in src/c/theme.c (B&W watches have one)
+//   second tz GMT hand offset, minutes east of UTC; any value outside
+//             -720..840 turns the hand off
+var THEME_KEY = 'theme';
+var THEME_SENT_KEY = 'themeSent';
+var THEME_NAMES = ['Cyan', 'Orange', 'Green', 'White'];
+var SECOND_TZ_KEY = 'secondTzOffset';
+var SECOND_TZ_SENT_KEY = 'secondTzSent';
+var SECOND_TZ_OFF = 0x7fffffff;
+
+/**
+ * GET url; callback(responseText) on success or callback(null) on error,
+ * non-2xx status or after XHR_TIMEOUT_MS. Hung requests are aborted.
+ */
 var xhrRequest = function(url, type, callback) {
   var xhr = new XMLHttpRequest();
-  xhr.onload = function() { callback(this.responseText); };
+  var done = false;
+  var finish = function(text) {
+    if (done) return;
+    done = true;
+    clearTimeout(timer);
+    callback(text);
+  };
+  var timer = setTimeout(function() {
+    console.log('Weather request timed out');
+    xhr.abort();
+    finish(null);
+  }, XHR_TIMEOUT_MS);
+
+  xhr.onload = function() {
+    finish(this.status >= 200 && this.status < 300 ? this.responseText : null);
+  };
+  xhr.onerror = function() { finish(null); };
   xhr.open(type, url);
   xhr.send();
 };
@@ -31,38 +88,249 @@ function weatherCodeToIcon(code) {
   return 7;                          // Unknown
 }
 
-function locationSuccess(pos) {
+function clampInt8(value) {
+  return Math.max(-128, Math.min(127, Math.round(value)));
+}
+
+/**
+ * Packs current conditions and the hourly entries from the current hour on
+ * into the byte layout documented in src/c/weather_forecast.h
+ */
+function packWeather(json) {
+  var hourStart = Math.floor(Date.now() / 3600000) * 3600;
+  var times = json.hourly.time;
+  var first = 0;
+  while (first < times.length && times[first] < hourStart) first++;
+
+  var temps = [];
+  var icons = [];
+  for (var i = first; i < times.length && temps.length < FORECAST_HOURS; i++) {
+    temps.push(clampInt8(json.hourly.temperature_2m[i]) & 0xff);
+    icons.push(weatherCodeToIcon(json.hourly.weather_code[i]));
+  }
+  var start = first < times.length ? times[first] : hourStart;
+
+  var bytes = [
+    PACKED_VERSION,
+    temps.length,
+    start & 0xff, (start >>> 8) & 0xff, (start >>> 16) & 0xff, (start >>> 24) & 0xff,
+    clampInt8(json.current.temperature_2m) & 0xff,
+    weatherCodeToIcon(json.current.weather_code)
+  ].concat(temps);
+
+  // 3-bit icons, LSB-first
+  var iconBytes = [];
+  for (var b = 0; b < Math.ceil(icons.length * 3 / 8); b++) iconBytes.push(0);
+  icons.forEach(function(icon, n) {
+    var bit = n * 3;
+    iconBytes[bit >> 3] |= (icon << (bit & 7)) & 0xff;
+    if ((bit & 7) > 5) iconBytes[(bit >> 3) + 1] |= icon >> (8 - (bit & 7));
+  });
+  return bytes.concat(iconBytes);
+}
+
+function cacheKey(lat, lon) {
+  return CACHE_PREFIX + Math.round(lat / CACHE_GRID_DEG) + ',' + Math.round(lon / CACHE_GRID_DEG);
+}
+
+// Great-circle distance in km
+function distanceKm(lat1, lon1, lat2, lon2) {
+  var rad = Math.PI / 180;
+  var dLat = (lat2 - lat1) * rad;
+  var dLon = (lon2 - lon1) * rad;
+  var a = Math.sin(dLat / 2) * Math.sin(dLat / 2) +
+          Math.cos(lat1 * rad) * Math.cos(lat2 * rad) * Math.sin(dLon / 2) * Math.sin(dLon / 2);
+  return 12742 * Math.atan2(Math.sqrt(a), Math.sqrt(1 - a));
+}
+
+// Returns the cached response for this position if it is fresh and close enough
+function readCache(lat, lon) {
+  var entry;
+  try {
+    entry = JSON.parse(localStorage.getItem(cacheKey(lat, lon)));
+  } catch (e) {
+    return null;
+  }
+  if (!entry || Date.now() - entry.fetchedAt > CACHE_TTL_MS) return null;
+  if (distanceKm(lat, lon, entry.lat, entry.lon) > CACHE_MAX_MOVE_KM) return null;
+  return entry.json;
+}
+
+// Stores json for this position and drops expired entries for other cells
+function writeCache(lat, lon, json) {
+  var now = Date.now();
+  for (var i = localStorage.length - 1; i >= 0; i--) {
+    var key = localStorage.key(i);
+    if (!key || key.indexOf(CACHE_PREFIX) !== 0) continue;
+    try {
+      if (now - JSON.parse(localStorage.getItem(key)).fetchedAt > CACHE_TTL_MS) {
+        localStorage.removeItem(key);
+      }
+    } catch (e) {
+      localStorage.removeItem(key);
+    }
+  }
+  localStorage.setItem(cacheKey(lat, lon),
+    JSON.stringify({ fetchedAt: now, lat: lat, lon: lon, json: json }));
+}
+
+// Stamps a message with the phone's clock, ms since the epoch mod 2^31 so it
+// fits an int32; the profiling build turns it into transfer latency
+function stamped(payload) {
+  payload['SENT_AT'] = Date.now() % 0x80000000;
+  return payload;
+}
+
+function sendWeather(json, done) {
+  Pebble.sendAppMessage(
+    stamped({ 'WEATHER_PACKED': packWeather(json) }),
+    function() {
+      console.log('Weather sent to Pebble');
+      localStorage.setItem(SENT_AT_KEY, String(Date.now()));
+      done();
+    },
+    function() {
+      console.log('Error sending weather to Pebble');
+      done();
+    }
+  );
+}
+
+function locationSuccess(pos, done) {
+  var lat = pos.coords.latitude;
+  var lon = pos.coords.longitude;
+
+  var cached = readCache(lat, lon);
+  if (cached) {
+    console.log('Using cached weather');
+    sendWeather(cached, done);
+    return;
+  }
+
   var url = 'https://api.open-meteo.com/v1/forecast?' +
-    'latitude=' + pos.coords.latitude +
-    '&longitude=' + pos.coords.longitude +
-    '&current=temperature_2m,weather_code';
+    'latitude=' + lat +
+    '&longitude=' + lon +
+    '&current=temperature_2m,weather_code' +
+    '&hourly=temperature_2m,weather_code' +
+    '&forecast_hours=' + (FORECAST_HOURS + 1) +
+    '&timeformat=unixtime';
 
   xhrRequest(url, 'GET', function(responseText) {
-    var json = JSON.parse(responseText);
-    var temperature = Math.round(json.current.temperature_2m);
-    var icon = weatherCodeToIcon(json.current.weather_code);
-
-    Pebble.sendAppMessage(
-      { 'TEMPERATURE': temperature, 'WEATHER_ICON': icon },
-      function() { console.log('Weather sent to Pebble'); },
-      function() { console.log('Error sending weather to Pebble'); }
-    );
+    var json = null;
+    try {
+      json = responseText && JSON.parse(responseText);
+    } catch (e) {
+      console.log('Bad weather response');
+    }
+    if (!json || !json.current || !json.hourly) {
+      done();
+      return;
+    }
+    writeCache(lat, lon, json);
+    sendWeather(json, done);
   });
 }
 
-function locationError(err) {
-  console.log('Location error: ' + err.message);
-}
+// Only one fetch runs at a time; triggers that arrive meanwhile are served
+// by the one already in flight.
+var fetchInFlight = false;
 
 function fetchWeather() {
+  if (fetchInFlight) {
+    console.log('Weather fetch already in flight');
+    return;
+  }
+  fetchInFlight = true;
+  var done = function() { fetchInFlight = false; };
+
   navigator.geolocation.getCurrentPosition(
-    locationSuccess,
-    locationError,
+    function(pos) { locationSuccess(pos, done); },
+    function(err) {
+      console.log('Location error: ' + err.message);
+      done();
+    },
     { timeout: 15000, maximumAge: 300000 }
   );
 }
 
+function lastSentIsFresh() {
+  var sentAt = parseInt(localStorage.getItem(SENT_AT_KEY), 10);
+  return !isNaN(sentAt) && Date.now() - sentAt < WEATHER_FRESH_MS;
+}
+
+// Sends the settings that changed since they were last delivered, in one
+// message (the watch's inbox is sized for THEME + SECOND_TZ + SENT_AT)
+function sendSettings() {
+  var theme = localStorage.getItem(THEME_KEY);
+  var offset = localStorage.getItem(SECOND_TZ_KEY);
+  var payload = {};
+  if (theme !== null && theme !== localStorage.getItem(THEME_SENT_KEY)) {
+    payload['THEME'] = parseInt(theme, 10) || 0;
+  }
+  if (offset !== null && offset !== localStorage.getItem(SECOND_TZ_SENT_KEY)) {
+    var minutes = parseInt(offset, 10);
+    payload['SECOND_TZ'] = isNaN(minutes) ? SECOND_TZ_OFF : minutes;
+  }
+  if (Object.keys(payload).length === 0) return;
+
+  Pebble.sendAppMessage(
+    stamped(payload),
+    function() {
+      if (payload['THEME'] !== undefined) localStorage.setItem(THEME_SENT_KEY, theme);
+      if (payload['SECOND_TZ'] !== undefined) localStorage.setItem(SECOND_TZ_SENT_KEY, offset);
+    },
+    function() { console.log('Error sending settings to Pebble'); }
+  );
+}
+
+// Configuration page, served inline: a theme picker and the second zone's
+// offset in hours (blank = off). Closing it returns the choice as JSON.
+function configPage() {
+  var theme = parseInt(localStorage.getItem(THEME_KEY), 10) || 0;
+  var minutes = parseInt(localStorage.getItem(SECOND_TZ_KEY), 10);
+  var hours = isNaN(minutes) || minutes === SECOND_TZ_OFF ? '' : String(minutes / 60);
+  var options = THEME_NAMES.map(function(name, i) {
+    return '<option value="' + i + '"' + (i === theme ? ' selected' : '') + '>' + name + '</option>';
+  }).join('');
+  return '<!DOCTYPE html><html><head><meta name="viewport" content="width=device-width">' +
+    '<style>body{font-family:sans-serif;margin:16px}label{display:block;margin:12px 0 4px}' +
+    'select,input,button{font-size:16px;width:100%}button{margin-top:20px}</style></head><body>' +
+    '<label for="theme">Theme (color watches)</label><select id="theme">' + options + '</select>' +
+    '<label for="tz">Second time zone, hours from UTC (blank for off)</label>' +
+    '<input id="tz" type="number" step="0.25" min="-12" max="14" value="' + hours + '">' +
+    '<button id="save">Save</button><script>' +
+    'document.getElementById("save").onclick=function(){' +
+    'var h=document.getElementById("tz").value;' +
+    'var r={theme:parseInt(document.getElementById("theme").value,10),' +
+    'secondTz:h===""?null:Math.round(parseFloat(h)*60)};' +
+    'document.location="pebblejs://close#"+encodeURIComponent(JSON.stringify(r));};' +
+    '</script></body></html>';
+}
+
+Pebble.addEventListener('showConfiguration', function() {
+  Pebble.openURL('data:text/html,' + encodeURIComponent(configPage()));
+});
+
+Pebble.addEventListener('webviewclosed', function(e) {
+  var settings;
+  try {
+    settings = JSON.parse(decodeURIComponent(e.response));
+  } catch (err) {
+    return;  // closed without saving
+  }
+  if (!settings) return;
+  if (typeof settings.theme === 'number') localStorage.setItem(THEME_KEY, String(settings.theme));
+  localStorage.setItem(SECOND_TZ_KEY,
+    typeof settings.secondTz === 'number' ? String(settings.secondTz) : String(SECOND_TZ_OFF));
+  sendSettings();
+});
+
 Pebble.addEventListener('ready', function() {
+  sendSettings();
+  if (lastSentIsFresh()) {
+    console.log('PebbleKit JS ready — watch already has fresh weather');
+    return;
+  }
   console.log('PebbleKit JS ready — fetching weather');
   fetchWeather();
 });
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""
+Emulator performance suite.
+
+Builds the watchface with WATCHFACE_PROFILE=1 and WATCHFACE_SCENARIO=1, then for
+each platform installs it on the emulator, captures the log stream while the
+scripted scenario in src/c/scenario.c runs (24 h of minute ticks, shake
+bursts, weather pushes), and writes one comparison report across platforms.
+Each layout (the layered tree, and the WATCHFACE_COMPOSITOR single layer) is
+built and run in turn, and their whole-frame times are compared per platform.
+
+    tools/emu_bench.py                      # every targetPlatform, both layouts
+    tools/emu_bench.py --platforms aplite chalk --layouts layers --no-build
+
+Needs the `pebble` tool on PATH. Raw logs and report.md go to build/emu_bench/.
+"""
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+FRAMES_RE = re.compile(r'profile \[(?P<phase>[\w-]+)\] (?P<frames>\d+) frames in (?P<secs>\d+) s '
+                       r'\((?P<fpm>\d+) frames/min\)')
+LAYER_RE = re.compile(r'profile (?P<layer>\w+)\s+n=(?P<n>\d+) min=(?P<min>\d+) avg=(?P<avg>\d+) '
+                      r'max=(?P<max>\d+) p95=(?P<p95>\d+\+?) ms '
+                      r'tick=(?P<tick>\d+) tap=(?P<tap>\d+) weather=(?P<weather>\d+)')
+HEAP_RE = re.compile(r'(?:scenario|profile) heap \[(?P<phase>[\w-]+)\] '
+                     r'used=(?P<used>\d+) free=(?P<free>\d+)')
+STARTUP_RE = re.compile(r'profile startup first-frame=(?P<ms>\d+) ms')
+INBOX_RE = re.compile(r'profile inbox n=(?P<n>\d+) dropped=(?P<dropped>\d+) overflow=(?P<overflow>\d+) '
+                      r'latency min=(?P<min>\d+) avg=(?P<avg>\d+) max=(?P<max>\d+) ms')
+OUTBOX_RE = re.compile(r'profile outbox sent=(?P<sent>\d+) busy=(?P<busy>\d+) oom=(?P<oom>\d+) '
+                       r'failed=(?P<failed>\d+)')
+DONE_MARKER = 'scenario done'
+
+# layout name -> extra build environment
+LAYOUTS = {
+    'layers': {},
+    'compositor': {'WATCHFACE_COMPOSITOR': '1'},
+}
+
+
+def target_platforms():
+    with open(os.path.join(ROOT, 'package.json')) as f:
+        return json.load(f)['pebble']['targetPlatforms']
+
+
+def build(layout):
+    env = dict(os.environ, WATCHFACE_PROFILE='1', WATCHFACE_SCENARIO='1')
+    env.pop('WATCHFACE_COMPOSITOR', None)
+    env.update(LAYOUTS[layout])
+    subprocess.check_call(['pebble', 'build'], cwd=ROOT, env=env)
+
+
+def run_platform(platform, timeout, log_path):
+    """Installs on the emulator and streams logs until the scenario finishes."""
+    cmd = ['pebble', 'install', '--emulator', platform, '--logs']
+    proc = subprocess.Popen(cmd, cwd=ROOT, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    lines = []
+    deadline = time.time() + timeout
+    try:
+        with open(log_path, 'w') as log:
+            for line in proc.stdout:
+                log.write(line)
+                lines.append(line.rstrip('\n'))
+                if DONE_MARKER in line:
+                    break
+                if time.time() > deadline:
+                    sys.stderr.write('%s: timed out after %d s\n' % (platform, timeout))
+                    break
+    finally:
+        proc.terminate()
+        proc.wait()
+        subprocess.call(['pebble', 'kill'], cwd=ROOT)
+    return lines
+
+
+def parse(lines):
+    """Returns {phase: {'frames': .., 'fpm': .., 'layers': {..}, 'heap': (used, free)}}.
+
+    The 'startup' phase also carries 'first_frame_ms', main() to the first hands frame.
+    Phases with AppMessage traffic carry 'inbox' and 'outbox' counter dicts.
+    """
+    phases, current = {}, None
+    for line in lines:
+        m = FRAMES_RE.search(line)
+        if m:
+            current = phases.setdefault(m.group('phase'), {'layers': {}})
+            current['frames'] = int(m.group('frames'))
+            current['fpm'] = int(m.group('fpm'))
+            continue
+        m = LAYER_RE.search(line)
+        if m and current is not None:
+            current['layers'][m.group('layer')] = m.groupdict()
+            continue
+        m = INBOX_RE.search(line) or OUTBOX_RE.search(line)
+        if m and current is not None:
+            current['inbox' if m.re is INBOX_RE else 'outbox'] = m.groupdict()
+            continue
+        m = HEAP_RE.search(line)
+        if m:
+            phase = phases.setdefault(m.group('phase'), {'layers': {}})
+            phase['heap'] = (int(m.group('used')), int(m.group('free')))
+            continue
+        m = STARTUP_RE.search(line)
+        if m:
+            phases.setdefault('startup', {'layers': {}})['first_frame_ms'] = int(m.group('ms'))
+    return phases
+
+
+def layout_comparison(results):
+    """Rows of (platform, phase, {layout: frame layer stats}) where more than one layout ran."""
+    rows = {}
+    for (platform, layout), per_platform in results.items():
+        for phase, data in per_platform.items():
+            frame = data['layers'].get('frame')
+            if frame:
+                rows.setdefault((platform, phase), {})[layout] = frame
+    return [(p, ph, by_layout) for (p, ph), by_layout in rows.items() if len(by_layout) > 1]
+
+
+def write_report(results, path):
+    """results is keyed by (platform, layout)."""
+    out = ['# Emulator performance report', '']
+
+    comparison = layout_comparison(results)
+    if comparison:
+        out.append('## Layouts: whole frame, face start to last update proc end')
+        out.append('')
+        out.append('| platform | phase | %s | faster |' % ' | '.join(
+            '%s avg/p95 ms' % layout for layout in LAYOUTS))
+        out.append('|---|---|%s---|' % ('---|' * len(LAYOUTS)))
+        for platform, phase, by_layout in comparison:
+            cells = ['%s/%s' % (by_layout[l]['avg'], by_layout[l]['p95']) if l in by_layout else '-'
+                     for l in LAYOUTS]
+            faster = min(by_layout, key=lambda l: int(by_layout[l]['avg']))
+            out.append('| %s | %s | %s | %s |' % (platform, phase, ' | '.join(cells), faster))
+        out.append('')
+
+    # The per-phase tables below list each run as platform/layout
+    results = dict(('%s/%s' % key, value) for key, value in results.items())
+
+    out.append('| platform | first frame ms |')
+    out.append('|---|---|')
+    for platform, per_platform in results.items():
+        out.append('| %s | %s |' % (
+            platform, per_platform.get('startup', {}).get('first_frame_ms', '-')))
+    out.append('')
+
+    phases = []
+    for per_platform in results.values():
+        for phase in per_platform:
+            if phase not in phases:
+                phases.append(phase)
+
+    for phase in phases:
+        out.append('## %s' % phase)
+        out.append('')
+        out.append('| platform | frames | frames/min | layer | n | avg ms | p95 ms | max ms '
+                   '| heap used | heap free |')
+        out.append('|---|---|---|---|---|---|---|---|---|---|')
+        for platform, per_platform in results.items():
+            data = per_platform.get(phase)
+            if not data:
+                out.append('| %s | - | - | - | - | - | - | - | - | - |' % platform)
+                continue
+            used, free = data.get('heap', ('-', '-'))
+            layers = data['layers'] or {'-': {'n': '-', 'avg': '-', 'p95': '-', 'max': '-'}}
+            for name, layer in sorted(layers.items()):
+                out.append('| %s | %s | %s | %s | %s | %s | %s | %s | %s | %s |' % (
+                    platform, data.get('frames', '-'), data.get('fpm', '-'), name,
+                    layer['n'], layer['avg'], layer['p95'], layer['max'], used, free))
+        out.append('')
+
+    messages = ['## AppMessage', '',
+                '| platform | phase | in | dropped | overflow | latency avg ms | latency max ms '
+                '| sent | busy | oom | failed |',
+                '|---|---|---|---|---|---|---|---|---|---|---|']
+    for platform, per_platform in results.items():
+        for phase, data in per_platform.items():
+            if 'inbox' not in data and 'outbox' not in data:
+                continue
+            inbox = data.get('inbox', {})
+            outbox = data.get('outbox', {})
+            messages.append('| %s | %s | %s | %s | %s | %s | %s | %s | %s | %s | %s |' % (
+                platform, phase, inbox.get('n', '-'), inbox.get('dropped', '-'),
+                inbox.get('overflow', '-'), inbox.get('avg', '-'), inbox.get('max', '-'),
+                outbox.get('sent', '-'), outbox.get('busy', '-'), outbox.get('oom', '-'),
+                outbox.get('failed', '-')))
+    if len(messages) > 4:
+        out += messages + ['']
+
+    with open(path, 'w') as f:
+        f.write('\n'.join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--platforms', nargs='+', default=None,
+                        help='platforms to run (default: targetPlatforms in package.json)')
+    parser.add_argument('--timeout', type=int, default=300,
+                        help='seconds to wait for the scenario on each platform')
+    parser.add_argument('--layouts', nargs='+', choices=list(LAYOUTS), default=list(LAYOUTS),
+                        help='layouts to build and run (default: all)')
+    parser.add_argument('--no-build', action='store_true',
+                        help='reuse the existing build (one layout only)')
+    args = parser.parse_args()
+    if args.no_build and len(args.layouts) > 1:
+        parser.error('--no-build reuses a single build; pass one --layouts entry')
+
+    out_dir = os.path.join(ROOT, 'build', 'emu_bench')
+    if not os.path.isdir(out_dir):
+        os.makedirs(out_dir)
+
+    results = {}
+    for layout in args.layouts:
+        if not args.no_build:
+            build(layout)
+        for platform in args.platforms or target_platforms():
+            print('== %s/%s' % (platform, layout))
+            log_path = os.path.join(out_dir, '%s-%s.log' % (platform, layout))
+            results[(platform, layout)] = parse(run_platform(platform, args.timeout, log_path))
+
+    report = os.path.join(out_dir, 'report.md')
+    write_report(results, report)
+    print('Report written to %s' % report)
+
+
+if __name__ == '__main__':
+    main()
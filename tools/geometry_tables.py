@@ -0,0 +1,230 @@
+"""
+Build-time geometry tables for the watchface.
+
+Mirrors the integer math in src/c/watchface.c (watchface_geometry_init and the
+get_point_on_* helpers) for a fixed screen size and emits a C header holding
+the resulting tables as const data, so they live in flash instead of RAM and
+nothing is computed at startup.
+
+Layout constants are parsed from src/c/watchface.h so the two never drift.
+"""
+import math
+import re
+
+TRIG_MAX_ANGLE = 0x10000
+TRIG_MAX_RATIO = 0xffff
+
+# Screen size and shape of every platform the SDK can target
+PLATFORMS = {
+    'aplite':  (144, 168, False),
+    'basalt':  (144, 168, False),
+    'chalk':   (180, 180, True),
+    'diorite': (144, 168, False),
+    'emery':   (200, 228, False),
+    'flint':   (144, 168, False),
+    'gabbro':  (260, 260, True),
+}
+
+
+def parse_defines(header_text):
+    """Returns every '#define NAME <integer>' in header_text as a dict."""
+    defines = {}
+    for match in re.finditer(r'^#define\s+(\w+)\s+(-?\d+)\b', header_text, re.M):
+        defines[match.group(1)] = int(match.group(2))
+    return defines
+
+
+def cdiv(a, b):
+    """C integer division (truncates toward zero)."""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+def isqrt(n):
+    """floor(sqrt(n)) for 0 <= n < 2**58, same digit-by-digit loop as watchface.c."""
+    root, rem = 0, 0
+    for shift in range(56, -1, -2):
+        rem = (rem << 2) | ((n >> shift) & 3)
+        root <<= 1
+        trial = (root << 1) | 1
+        if rem >= trial:
+            rem -= trial
+            root |= 1
+    return root
+
+
+def sin_lookup(angle):
+    return int(round(math.sin(2 * math.pi * angle / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO))
+
+
+def cos_lookup(angle):
+    return int(round(math.cos(2 * math.pi * angle / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO))
+
+
+def degrees_to_trig_angle(degrees):
+    return cdiv(TRIG_MAX_ANGLE * degrees, 360)
+
+
+def revert_angle(angle):
+    return angle + 32768
+
+
+class Geometry(object):
+    def __init__(self, width, height, is_round, defs):
+        self.w, self.h, self.is_round, self.d = width, height, is_round, defs
+        self.cx = width // 2
+        self.cy = height // 2
+        self.w_radius = width // 2 - 2
+        self.h_radius = height // 2 - 2
+        self.radius = min(self.w_radius, self.h_radius)
+        self.num_offset = (defs['NUMBER_OFFSET_FROM_MARKER'] if self.radius > 90
+                           else cdiv(self.radius, 5))
+
+    def point_on_circle(self, angle, dist):
+        return (self.cx + cdiv(sin_lookup(angle) * dist, TRIG_MAX_RATIO),
+                self.cy - cdiv(cos_lookup(angle) * dist, TRIG_MAX_RATIO))
+
+    def point_on_rounded_rect(self, angle, w_radius, h_radius, corner_radius):
+        sin_val, cos_val = sin_lookup(angle), cos_lookup(angle)
+        cx, cy = w_radius - corner_radius, h_radius - corner_radius
+        abs_sin, abs_cos = abs(sin_val), abs(cos_val)
+
+        if abs_sin * h_radius > abs_cos * w_radius:
+            scale = cdiv(w_radius * TRIG_MAX_RATIO, abs_sin)
+        else:
+            scale = cdiv(h_radius * TRIG_MAX_RATIO, abs_cos)
+
+        px = cdiv(sin_val * scale, TRIG_MAX_RATIO)
+        py = -cdiv(cos_val * scale, TRIG_MAX_RATIO)
+        if not ((px > cx or px < -cx) and (py > cy or py < -cy)):
+            return (self.cx + px, self.cy + py)
+
+        arc_cx = cx if sin_val > 0 else -cx
+        arc_cy = -cy if cos_val > 0 else cy
+        dot = arc_cx * sin_val + arc_cy * (-cos_val)
+        cross = arc_cx * (-cos_val) - arc_cy * sin_val
+        r_trig = corner_radius * TRIG_MAX_RATIO
+        disc = (r_trig - abs(cross)) * (r_trig + abs(cross)) if abs(cross) < r_trig else 0
+        t = cdiv(dot + isqrt(disc), TRIG_MAX_RATIO)
+        return (self.cx + cdiv(sin_val * t, TRIG_MAX_RATIO),
+                self.cy - cdiv(cos_val * t, TRIG_MAX_RATIO))
+
+    def point_on_face(self, angle, w_dist, h_dist):
+        if self.is_round:
+            return self.point_on_circle(angle, w_dist)
+        return self.point_on_rounded_rect(angle, w_dist, h_dist,
+                                          self.d['SQR_WATCHFACE_RADIOUS'])
+
+    def face_tables(self):
+        d = self.d
+        face_w = self.w_radius - cdiv(d['CLOCK_FACE_STROKE_WIDTH'], 2)
+        face_h = self.h_radius - cdiv(d['CLOCK_FACE_STROKE_WIDTH'], 2)
+        offset = d['MAJOR_MARKER_LENGTH'] + self.num_offset
+        size = d['HOUR_LABEL_SIZE']
+        outer, inner, labels = [], [], [None] * d['HOUR_LABEL_COUNT']
+
+        for i in range(d['MINUTE_MARKER_COUNT']):
+            angle = degrees_to_trig_angle(i * 6)
+            major = i % d['MAJOR_MARKER_INTERVAL'] == 0
+            length = d['MAJOR_MARKER_LENGTH'] if major else d['MINOR_MARKER_LENGTH']
+            outer.append(self.point_on_face(angle, face_w, face_h))
+            inner.append(self.point_on_face(angle, face_w - length, face_h - length))
+            if major:
+                x, y = self.point_on_face(angle, face_w - offset, face_h - offset)
+                labels[i // d['MAJOR_MARKER_INTERVAL']] = (
+                    x - size // 2, y - size // 2, size, size)
+        return outer, inner, labels
+
+    def hands_tables(self):
+        d = self.d
+        hour_len = cdiv(self.radius * d['HOUR_HAND_LENGTH_PCT'], 100)
+        hour_inner = hour_len - cdiv(d['HOUR_HAND_WIDTH'], 2) + 1
+        minute_len = cdiv(self.radius * d['MINUTE_HAND_LENGTH_PCT'], 100)
+        second_len = cdiv(self.radius * d['SECOND_HAND_LENGTH_PCT'], 100)
+        tail_len = cdiv(self.radius * d['SECOND_HAND_TAIL_PCT'], 100)
+
+        hours = [degrees_to_trig_angle(deg) for deg in range(d['HOUR_HAND_POSITIONS'])]
+        minutes = [degrees_to_trig_angle(i * 6) for i in range(d['MINUTE_MARKER_COUNT'])]
+        sweep = [degrees_to_trig_angle(p * 360 // d['SWEEP_HAND_POSITIONS'])
+                 for p in range(d['SWEEP_HAND_POSITIONS'])]
+        return {
+            'hour_end':     [self.point_on_circle(a, hour_len) for a in hours],
+            'hour_inner':   [self.point_on_circle(a, hour_inner) for a in hours],
+            'minute_end':   [self.point_on_circle(a, minute_len) for a in minutes],
+            'second_start': [self.point_on_circle(revert_angle(a), tail_len) for a in minutes],
+            'second_end':   [self.point_on_circle(a, second_len) for a in minutes],
+            'sweep_start':  [self.point_on_circle(revert_angle(a), tail_len) for a in sweep],
+            'sweep_end':    [self.point_on_circle(a, second_len) for a in sweep],
+        }
+
+    def widget_rects(self):
+        d = self.d
+        face_h_edge = self.h_radius - cdiv(d['CLOCK_FACE_STROKE_WIDTH'], 2)
+        num_offset = d['MAJOR_MARKER_LENGTH'] + self.num_offset
+        half_label = d['HOUR_LABEL_SIZE'] // 2
+
+        label_bottom = self.cy - (face_h_edge - num_offset) + half_label
+        weather = (0, label_bottom + d['WEATHER_LABEL_GAP'], self.w, d['WEATHER_LAYER_HEIGHT'])
+
+        six_top = self.cy + (face_h_edge - num_offset) - half_label
+        mid_y = cdiv(self.cy + d['CENTER_DOT_RADIUS'] + six_top, 2)
+        date = (self.cx - d['DATE_WIDGET_WIDTH'] // 2, mid_y - d['DATE_WIDGET_HEIGHT'] // 2,
+                d['DATE_WIDGET_WIDTH'], d['DATE_WIDGET_HEIGHT'])
+        return weather, date
+
+
+def _points(points, indent='    '):
+    rows = []
+    for i in range(0, len(points), 6):
+        rows.append(indent + ', '.join('{ %d, %d }' % p for p in points[i:i + 6]))
+    return ',\n'.join(rows)
+
+
+def _rect(r):
+    return '{ { %d, %d }, { %d, %d } }' % r
+
+
+def generate_header(platform, header_text):
+    """Returns the generated C header for platform as a string."""
+    width, height, is_round = PLATFORMS[platform]
+    geometry = Geometry(width, height, is_round, parse_defines(header_text))
+    outer, inner, labels = geometry.face_tables()
+    hands = geometry.hands_tables()
+    weather, date = geometry.widget_rects()
+
+    out = []
+    out.append('// Generated by tools/geometry_tables.py for %s (%dx%d) - do not edit'
+               % (platform, width, height))
+    out.append('#pragma once')
+    out.append('')
+    out.append('#define GEOMETRY_TABLE_WIDTH   %d' % width)
+    out.append('#define GEOMETRY_TABLE_HEIGHT  %d' % height)
+    out.append('')
+    out.append('static const FaceGeometry s_face_geometry_table = {')
+    out.append('  .marker_outer = {\n%s\n  },' % _points(outer))
+    out.append('  .marker_inner = {\n%s\n  },' % _points(inner))
+    out.append('  .label_rect = {\n%s\n  },' % ',\n'.join('    ' + _rect(r) for r in labels))
+    out.append('};')
+    out.append('')
+    out.append('static const HandsGeometry s_hands_geometry_table = {')
+    for name in ('hour_end', 'hour_inner', 'minute_end', 'second_start', 'second_end'):
+        out.append('  .%s = {\n%s\n  },' % (name, _points(hands[name])))
+    # Only compiled into WATCHFACE_SMOOTH_SECONDS builds, like the fields
+    out.append('#if defined(WATCHFACE_SMOOTH_SECONDS)')
+    for name in ('sweep_start', 'sweep_end'):
+        out.append('  .%s = {\n%s\n  },' % (name, _points(hands[name])))
+    out.append('#endif')
+    out.append('};')
+    out.append('')
+    out.append('static const WidgetGeometry s_widget_geometry_table = {')
+    out.append('  .weather_frame = %s,' % _rect(weather))
+    out.append('  .date_rect     = %s,' % _rect(date))
+    out.append('};')
+    out.append('')
+    return '\n'.join(out)
+
+
+if __name__ == '__main__':
+    import sys
+    with open(sys.argv[2]) as header:
+        sys.stdout.write(generate_header(sys.argv[1], header.read()))
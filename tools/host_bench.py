@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+Host-side geometry and layout microbenchmarks.
+
+Builds src/c/bench.c (the WATCHFACE_BENCH cases) natively against the SDK
+shim in tools/host_render/, once per platform so each run uses that screen's
+resolution and generated tables, and:
+
+  * times every case over all 60 marker angles, in ns/call and, where the
+    kernel exposes perf events, retired instructions/call
+  * checks every geometry table entry against the direct math pixel for
+    pixel, and fails on any mismatch (tools/host_render.py checks the
+    rounded-rect solve against its 64-bit reference)
+  * fails on any compiler warning
+
+    tools/host_bench.py                     # every targetPlatform
+    tools/host_bench.py --platforms emery
+
+Needs only a C compiler (cc, or $CC); cases are built with -Os like the
+watch build. Host timings and x86/arm64 instruction counts are for comparing
+versions of this code, not a stand-in for the watch - bench.c runs the same
+cases on the device. The report goes to build/host_bench/report.md.
+"""
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+import host_render
+
+SOURCES = ['watchface.c', 'bench.c']
+SHIM_SOURCES = ['raster.c', 'pebble_host.c', 'bench_driver.c']
+
+
+def write_report(results, path):
+    out = ['# Host bench report', '']
+    out.append('| platform | case | resolution | ns/call | instructions/call |')
+    out.append('|---|---|---|---|---|')
+    for platform, r in results.items():
+        for case in r['cases']:
+            instructions = case['instructions_per_call']
+            out.append('| %s | %s | %s | %.1f | %s |' % (
+                platform, case['name'], case['resolution'], case['ns_per_call'],
+                'n/a' if instructions is None else '%.1f' % instructions))
+    out.append('')
+    out.append('Geometry table mismatches: %s' % ', '.join(
+        '%s %d' % (platform, r['mismatches']) for platform, r in results.items()))
+    out.append('')
+    with open(path, 'w') as f:
+        f.write('\n'.join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--platforms', nargs='+', default=None,
+                        help='platforms to run (default: targetPlatforms in package.json)')
+    args = parser.parse_args()
+
+    out_dir = os.path.join(host_render.ROOT, 'build', 'host_bench')
+    results, failed = {}, False
+    for platform in args.platforms or host_render.target_platforms():
+        print('== %s' % platform)
+        work_dir = os.path.join(out_dir, platform)
+        binary = os.path.join(work_dir, 'host_bench')
+        warnings = host_render.compile_host(binary, platform, ['WATCHFACE_BENCH'],
+                                            SHIM_SOURCES, SOURCES, work_dir, opt='-Os')
+        proc = subprocess.run([binary], stdout=subprocess.PIPE, universal_newlines=True)
+        result = json.loads(proc.stdout)
+
+        problems = []
+        if warnings:
+            print(warnings)
+            problems.append('compiler warnings')
+        if result['mismatches']:
+            problems.append('%d geometry table entries differ' % result['mismatches'])
+        if problems:
+            failed = True
+            print('   %s' % ', '.join(problems))
+        for case in result['cases']:
+            instructions = case['instructions_per_call']
+            print('   %-26s %-8s %8.1f ns/call  %s' % (
+                case['name'], case['resolution'], case['ns_per_call'],
+                'n/a' if instructions is None else '%.1f instructions/call' % instructions))
+        results[platform] = result
+
+    report = os.path.join(out_dir, 'report.md')
+    write_report(results, report)
+    print('Report written to %s' % report)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
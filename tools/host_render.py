@@ -0,0 +1,294 @@
+#!/usr/bin/env python3
+"""
+Host-side render check.
+
+Compiles the real drawing modules in src/c against the SDK shim in
+tools/host_render/ (a small software rasterizer plus in-memory services) once
+per platform and renderer (line or GPath hands, or the single-layer
+compositor), renders a fixed instant, and:
+
+  * compares each frame against the golden PNGs in tools/host_render/golden/;
+    the compositor build must match the layered GPath golden exactly
+  * checks that the warm frame (caches filled) matches the cold one
+  * fails on any compiler warning in the watchface sources or the shim
+  * on rect platforms, checks the face projection for every marker angle
+    against the 64-bit reference solve it replaced and the generated tables
+  * writes an overdraw heatmap and per-layer, per-call draw counts
+
+    tools/host_render.py                    # every targetPlatform
+    tools/host_render.py --platforms chalk --update
+
+Needs only a C compiler (cc, or $CC). Frames, heatmaps and report.md go to
+build/host_render/. The shim draws aliased and with a 5x7 font, so goldens
+track changes to this tree, not the exact firmware output.
+"""
+import argparse
+import json
+import os
+import struct
+import subprocess
+import sys
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SHIM_DIR = os.path.join(ROOT, 'tools', 'host_render')
+GOLDEN_DIR = os.path.join(SHIM_DIR, 'golden')
+
+sys.path.insert(0, os.path.join(ROOT, 'tools'))
+import geometry_tables  # noqa: E402
+
+SOURCES = [
+    'watchface.c', 'layer_face.c', 'layer_date.c', 'layer_hands.c', 'layer_seconds.c',
+    'layer_weather.c', 'bitmap_capture.c', 'theme.c', 'render_scheduler.c', 'power_governor.c',
+    'profile.c', 'startup.c', 'second_tz.c', 'weather_forecast.c', 'sparkline.c', 'compositor.c',
+    'battery_policy.c',
+]
+SHIM_SOURCES = ['raster.c', 'pebble_host.c', 'driver.c']
+COLOR_PLATFORMS = ('basalt', 'chalk', 'emery')
+# name -> (defines, golden the frame must match)
+RENDERERS = {
+    'gpath': (['HANDS_USE_GPATH=1'], 'gpath'),
+    'lines': (['HANDS_USE_GPATH=0'], 'lines'),
+    'compositor': (['HANDS_USE_GPATH=1', 'WATCHFACE_COMPOSITOR'], 'gpath'),
+}
+
+# Overdraw heatmap: writes per pixel -> color; the last entry covers the rest
+HEAT = [(0, 0, 0), (40, 40, 160), (40, 160, 40), (220, 200, 40), (230, 110, 30), (230, 30, 30)]
+
+
+def target_platforms():
+    with open(os.path.join(ROOT, 'package.json')) as f:
+        return json.load(f)['pebble']['targetPlatforms']
+
+
+# ============================================================================
+# IMAGES
+# ============================================================================
+
+def read_pnm(path):
+    """Returns (width, height, channels, data) of a binary PPM or PGM."""
+    with open(path, 'rb') as f:
+        raw = f.read()
+    fields, pos = [], 0
+    while len(fields) < 4:
+        while raw[pos:pos + 1].isspace():
+            pos += 1
+        end = pos
+        while not raw[end:end + 1].isspace():
+            end += 1
+        fields.append(raw[pos:end])
+        pos = end
+    channels = {b'P6': 3, b'P5': 1}[fields[0]]
+    width, height = int(fields[1]), int(fields[2])
+    return width, height, channels, raw[pos + 1:]
+
+
+def write_png(path, width, height, rgb):
+    rows = b''.join(b'\0' + rgb[y * width * 3:(y + 1) * width * 3] for y in range(height))
+
+    def chunk(kind, data):
+        body = kind + data
+        return struct.pack('>I', len(data)) + body + struct.pack('>I', zlib.crc32(body) & 0xffffffff)
+
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(rows, 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+def read_png(path):
+    """Reads back what write_png wrote (8-bit RGB, filter 0): (width, height, rgb)."""
+    with open(path, 'rb') as f:
+        raw = f.read()
+    pos, idat, width, height = 8, b'', 0, 0
+    while pos < len(raw):
+        length, kind = struct.unpack('>I4s', raw[pos:pos + 8])
+        data = raw[pos + 8:pos + 8 + length]
+        if kind == b'IHDR':
+            width, height = struct.unpack('>II', data[:8])
+        elif kind == b'IDAT':
+            idat += data
+        pos += 12 + length
+    rows = zlib.decompress(idat)
+    stride = width * 3 + 1
+    if any(rows[y * stride] != 0 for y in range(height)):
+        raise ValueError('%s: unsupported PNG filter' % path)
+    return width, height, b''.join(rows[y * stride + 1:(y + 1) * stride] for y in range(height))
+
+
+def heatmap(counts):
+    out = bytearray()
+    for count in counts:
+        out += bytes(HEAT[min(count, len(HEAT) - 1)])
+    return bytes(out)
+
+
+# ============================================================================
+# BUILD AND RUN
+# ============================================================================
+
+def platform_defines(platform):
+    width, height, is_round = geometry_tables.PLATFORMS[platform]
+    defines = [
+        'PBL_COLOR' if platform in COLOR_PLATFORMS else 'PBL_BW',
+        'PBL_ROUND' if is_round else 'PBL_RECT',
+        'PBL_PLATFORM_%s' % platform.upper(),
+        'HOST_SCREEN_W=%d' % width,
+        'HOST_SCREEN_H=%d' % height,
+        'WATCHFACE_GEOMETRY_TABLES',
+    ]
+    if platform != 'aplite':
+        defines.append('PBL_HEALTH')
+    return defines
+
+
+def compile_host(binary, platform, defines, shim_sources, sources, work_dir, opt='-O1'):
+    """Compiles one host binary, using the same generated tables as the watch build.
+
+    Returns the compiler warnings. The shim stubs out most SDK calls, so only
+    unused parameters are let through. Also used by tools/host_bench.py.
+    """
+    gen_dir = os.path.join(work_dir, 'generated')
+    if not os.path.isdir(gen_dir):
+        os.makedirs(gen_dir)
+    with open(os.path.join(ROOT, 'src', 'c', 'watchface.h')) as f:
+        header = geometry_tables.generate_header(platform, f.read())
+    with open(os.path.join(gen_dir, 'watchface_geometry_table.h'), 'w') as f:
+        f.write(header)
+
+    cmd = [os.environ.get('CC', 'cc'), '-std=gnu99', opt, '-Wall', '-Wextra',
+           '-Wno-unused-parameter', '-o', binary,
+           '-I' + SHIM_DIR, '-I' + os.path.join(ROOT, 'src', 'c'), '-I' + gen_dir]
+    cmd += ['-D' + d for d in platform_defines(platform) + defines]
+    cmd += [os.path.join(SHIM_DIR, s) for s in shim_sources]
+    cmd += [os.path.join(ROOT, 'src', 'c', s) for s in sources]
+    cmd += ['-lm']
+    proc = subprocess.run(cmd, stderr=subprocess.PIPE, universal_newlines=True)
+    if proc.returncode:
+        sys.stderr.write(proc.stderr)
+        raise subprocess.CalledProcessError(proc.returncode, cmd)
+    return proc.stderr.strip()
+
+
+def build(platform, renderer, work_dir):
+    """Returns (binary, compiler warnings) for one platform and renderer."""
+    binary = os.path.join(work_dir, 'host_render_' + renderer)
+    warnings = compile_host(binary, platform, RENDERERS[renderer][0], SHIM_SOURCES, SOURCES,
+                            work_dir)
+    return binary, warnings
+
+
+def run(binary, frame_dir):
+    if not os.path.isdir(frame_dir):
+        os.makedirs(frame_dir)
+    stats = json.loads(subprocess.check_output([binary, frame_dir], universal_newlines=True))
+    frames = {}
+    for name in ('cold', 'warm'):
+        width, height, _, rgb = read_pnm(os.path.join(frame_dir, name + '.ppm'))
+        frames[name] = rgb
+    _, _, _, counts = read_pnm(os.path.join(frame_dir, 'overdraw.pgm'))
+    return width, height, frames, bytearray(counts), stats
+
+
+def check_golden(name, width, height, rgb, update):
+    """Returns None when the frame matches its golden, else a short description.
+
+    With update, writes the golden instead; a build checked against another
+    build's golden only compares.
+    """
+    path = os.path.join(GOLDEN_DIR, name + '.png')
+    if update:
+        write_png(path, width, height, rgb)
+        return None
+    if not os.path.exists(path):
+        return 'no golden (run with --update)'
+    g_width, g_height, golden = read_png(path)
+    if (g_width, g_height) != (width, height):
+        return 'size %dx%d, golden %dx%d' % (width, height, g_width, g_height)
+    diff = sum(1 for i in range(0, len(rgb), 3) if rgb[i:i + 3] != golden[i:i + 3])
+    return '%d pixels differ' % diff if diff else None
+
+
+# ============================================================================
+# REPORT
+# ============================================================================
+
+def write_report(results, path):
+    out = ['# Host render report', '']
+    out.append('| platform | hands | golden | warm == cold | pixels written | overdraw max | '
+               'overdrawn px |')
+    out.append('|---|---|---|---|---|---|---|')
+    for key, r in results.items():
+        out.append('| %s | %s | %s | %s | %d | %d | %d |' % (
+            key[0], key[1], r['golden'] or 'ok', 'yes' if r['stable'] else 'NO',
+            sum(r['counts']), max(r['counts']), sum(1 for c in r['counts'] if c > 1)))
+    out.append('')
+
+    out.append('## Draw calls, warm frame (calls / pixel writes)')
+    out.append('')
+    out.append('| platform | hands | layer | calls |')
+    out.append('|---|---|---|---|')
+    for key, r in results.items():
+        for layer, calls in r['stats']['warm'].items():
+            cells = ', '.join('%s %d/%d' % (call, n, px) for call, (n, px) in sorted(calls.items()))
+            out.append('| %s | %s | %s | %s |' % (key[0], key[1], layer, cells or '-'))
+    out.append('')
+
+    with open(path, 'w') as f:
+        f.write('\n'.join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--platforms', nargs='+', default=None,
+                        help='platforms to render (default: targetPlatforms in package.json)')
+    parser.add_argument('--update', action='store_true',
+                        help='rewrite the golden PNGs instead of comparing against them')
+    args = parser.parse_args()
+
+    out_dir = os.path.join(ROOT, 'build', 'host_render')
+    if not os.path.isdir(GOLDEN_DIR):
+        os.makedirs(GOLDEN_DIR)
+
+    results, failed = {}, False
+    for platform in args.platforms or target_platforms():
+        for renderer in RENDERERS:
+            name = '%s-%s' % (platform, renderer)
+            print('== %s' % name)
+            work_dir = os.path.join(out_dir, platform)
+            binary, warnings = build(platform, renderer, work_dir)
+            width, height, frames, counts, stats = run(binary, os.path.join(work_dir, renderer))
+
+            write_png(os.path.join(out_dir, name + '.png'), width, height, frames['warm'])
+            write_png(os.path.join(out_dir, name + '-overdraw.png'), width, height,
+                      heatmap(counts))
+            golden_name = '%s-%s' % (platform, RENDERERS[renderer][1])
+            golden = check_golden(golden_name, width, height, frames['warm'],
+                                  args.update and golden_name == name)
+            stable = frames['warm'] == frames['cold']
+            projection = stats['projection']
+            problems = [golden] if golden else []
+            if warnings:
+                print(warnings)
+                problems.append('compiler warnings')
+            if not stable:
+                problems.append('warm frame != cold frame')
+            if projection['mismatched']:
+                problems.append('%d of %d projected points differ' % (
+                    projection['mismatched'], projection['checked']))
+            if problems:
+                failed = True
+                print('   %s' % ', '.join(problems))
+            results[(platform, renderer)] = {
+                'golden': golden, 'stable': stable, 'counts': counts, 'stats': stats,
+            }
+
+    report = os.path.join(out_dir, 'report.md')
+    write_report(results, report)
+    print('Report written to %s' % report)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,109 @@
+#include "host.h"
+#include "watchface.h"
+#include "bench.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Runs the WATCHFACE_BENCH microbenchmarks (src/c/bench.c) natively for this
+// build's screen, checks the geometry caches against the direct math, and
+// prints one JSON object to stdout:
+//   "mismatches"   geometry cache entries that differ from the direct math
+//   "cases"        per case: ns/call, and instructions/call from the CPU's
+//                  counter (null where perf events are unavailable)
+//
+// Host instructions are not Cortex-M instructions; compare them between
+// versions of the code, not against the watch.
+//
+// usage: host_bench
+
+// Each case is repeated until it has run this long, after one warm-up pass
+#define BENCH_MIN_NS      20000000
+#define BENCH_MAX_PASSES  1000
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// User-space retired instructions of this thread, or -1 without perf events
+// (no PMU in a VM, or perf_event_paranoid too strict)
+static int open_instruction_counter(void) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.size           = sizeof(attr);
+  attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+  attr.disabled       = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static uint64_t read_counter(int fd) {
+  uint64_t count = 0;
+  if (read(fd, &count, sizeof(count)) != sizeof(count)) return 0;
+  return count;
+}
+
+static void time_case(const BenchCase *c, const BenchResolution *r, int counter, bool last) {
+  c->run(r);  // warm-up: caches, branch predictors, lazy font setup
+
+  uint64_t calls = 0, instructions = 0, elapsed = 0;
+  for (int pass = 0; pass < BENCH_MAX_PASSES && elapsed < BENCH_MIN_NS; pass++) {
+    if (counter >= 0) {
+      ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+      ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    uint64_t start = now_ns();
+    calls += c->run(r);
+    elapsed += now_ns() - start;
+    if (counter >= 0) {
+      ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+      instructions += read_counter(counter);
+    }
+  }
+
+  printf("    {\"name\": \"%s\", \"resolution\": \"%s\", \"calls\": %llu, \"ns_per_call\": %.1f, ",
+         c->name, r ? r->name : "-", (unsigned long long)calls, (double)elapsed / calls);
+  if (counter >= 0) {
+    printf("\"instructions_per_call\": %.1f}", (double)instructions / calls);
+  } else {
+    printf("\"instructions_per_call\": null}");
+  }
+  printf("%s\n", last ? "" : ",");
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(int argc, char **argv) {
+  static char name[16];
+  snprintf(name, sizeof(name), "%dx%d", HOST_SCREEN_W, HOST_SCREEN_H);
+  BenchResolution screen = { name, HOST_SCREEN_W, HOST_SCREEN_H };
+
+  GRect bounds = GRect(0, 0, HOST_SCREEN_W, HOST_SCREEN_H);
+  watchface_geometry_init(bounds);
+  int mismatches = bench_check_geometry(bounds);
+  int counter    = open_instruction_counter();
+
+  printf("{\n");
+  printf("  \"mismatches\": %d,\n", mismatches);
+  printf("  \"cases\": [\n");
+  for (int i = 0; i < bench_case_count(); i++) {
+    const BenchCase *c = bench_case(i);
+    time_case(c, c->per_resolution ? &screen : NULL, counter, i == bench_case_count() - 1);
+  }
+  printf("  ]\n");
+  printf("}\n");
+
+  if (counter >= 0) close(counter);
+  return mismatches ? 1 : 0;
+}
@@ -0,0 +1,235 @@
+#include "host.h"
+#include "watchface.h"
+#include "layer_face.h"
+#include "layer_date.h"
+#include "layer_hands.h"
+#include "layer_seconds.h"
+#include "layer_weather.h"
+#include "weather_forecast.h"
+#include "theme.h"
+#include "compositor.h"
+
+// Builds the watchface's layer tree the way main.c's startup stages do,
+// renders a cold frame (caches empty) and a warm frame (caches filled), and
+// writes:
+//   <out>/cold.ppm, <out>/warm.ppm   the two frames, binary PPM
+//   <out>/overdraw.pgm               per-pixel write counts of the warm frame
+//   stdout                           per-layer, per-call counts as JSON, and
+//                                    how many face projections were checked
+//                                    against the reference solve (rect only)
+//
+// usage: host_render <out_dir>
+
+// 2015-06-15 10:09:30 UTC: hands well apart, date and highlight visible
+#define HOST_FIXED_TIME  1434362970
+
+// Forecast batch starting two hours back, so the sparkline has shifted twice:
+// version, count, start time (LE), current temp and icon (clear), 12 hourly
+// temps, 12 x 3-bit icons (all clear)
+static const uint8_t s_forecast[] = {
+  WEATHER_PACKED_VERSION, 12, 0x00, 0x86, 0x7e, 0x55, 21, 0,
+  15, 16, 18, 20, 21, 22, 23, 22, 20, 18, 17, 16,
+  0, 0, 0, 0, 0,
+};
+
+// ============================================================================
+// PRIVATE HELPERS
+// ============================================================================
+
+static void label_layer(Layer *layer, const char *label) {
+  layer->label = label;
+}
+
+static bool write_ppm(const char *path, const uint8_t *rgb) {
+  FILE *file = fopen(path, "wb");
+  if (!file) return false;
+  fprintf(file, "P6\n%d %d\n255\n", HOST_SCREEN_W, HOST_SCREEN_H);
+  fwrite(rgb, 3, HOST_SCREEN_W * HOST_SCREEN_H, file);
+  return fclose(file) == 0;
+}
+
+static bool write_overdraw(const char *path, const uint16_t *counts) {
+  FILE *file = fopen(path, "wb");
+  if (!file) return false;
+  fprintf(file, "P5\n%d %d\n255\n", HOST_SCREEN_W, HOST_SCREEN_H);
+  for (int i = 0; i < HOST_SCREEN_W * HOST_SCREEN_H; i++) {
+    fputc(counts[i] > 255 ? 255 : counts[i], file);
+  }
+  return fclose(file) == 0;
+}
+
+static void print_frame_stats(const char *name, bool last) {
+  printf("  \"%s\": {\n", name);
+  for (int i = 0; i < host_stats_count(); i++) {
+    const HostLabelStats *stats = host_stats_get(i);
+    printf("    \"%s\": {", stats->label);
+    bool first = true;
+    for (int c = 0; c < HostCallCount; c++) {
+      if (!stats->calls[c]) continue;
+      printf("%s\"%s\": [%u, %u]", first ? "" : ", ", host_call_name(c),
+             (unsigned)stats->calls[c], (unsigned)stats->pixels[c]);
+      first = false;
+    }
+    printf("}%s\n", i + 1 < host_stats_count() ? "," : "");
+  }
+  printf("  }%s\n", last ? "" : ",");
+}
+
+// ============================================================================
+// PROJECTION CHECK — the 32-bit corner solve against the 64-bit Newton one
+// it replaced, and against the generated tables the frames are drawn from
+// ============================================================================
+
+typedef struct {
+  int checked;
+  int mismatched;
+} ProjectionStats;
+
+#if defined(PBL_RECT)
+static int64_t reference_isqrt(int64_t n) {
+  if (n <= 0) return 0;
+  int64_t x = n;
+  int64_t y = (x + 1) / 2;
+  while (y < x) {
+    x = y;
+    y = (x + n / x) / 2;
+  }
+  return x;
+}
+
+static GPoint reference_point(int32_t angle, int w_radius, int h_radius, int corner_radius) {
+  int32_t sin_val = sin_lookup(angle);
+  int32_t cos_val = cos_lookup(angle);
+  int cx = w_radius - corner_radius;
+  int cy = h_radius - corner_radius;
+  int32_t abs_sin = sin_val > 0 ? sin_val : -sin_val;
+  int32_t abs_cos = cos_val > 0 ? cos_val : -cos_val;
+
+  int32_t scale;
+  if (abs_sin * h_radius > abs_cos * w_radius) {
+    scale = (int32_t)w_radius * TRIG_MAX_RATIO / abs_sin;
+  } else {
+    scale = (int32_t)h_radius * TRIG_MAX_RATIO / abs_cos;
+  }
+  int px = (int)(sin_val * scale / TRIG_MAX_RATIO);
+  int py = -(int)(cos_val * scale / TRIG_MAX_RATIO);
+  if (!((px > cx || px < -cx) && (py > cy || py < -cy))) {
+    return GPoint(s_watchface.center.x + px, s_watchface.center.y + py);
+  }
+
+  int arc_cx = (sin_val > 0) ?  cx : -cx;
+  int arc_cy = (cos_val > 0) ? -cy :  cy;
+  int64_t dot    = (int64_t)arc_cx * sin_val + (int64_t)arc_cy * (-cos_val);
+  int64_t cross  = (int64_t)arc_cx * (-cos_val) - (int64_t)arc_cy * sin_val;
+  int64_t r_trig = (int64_t)corner_radius * TRIG_MAX_RATIO;
+  int64_t t      = (dot + reference_isqrt(r_trig * r_trig - cross * cross)) / TRIG_MAX_RATIO;
+  return GPoint(s_watchface.center.x + (int)(sin_val * t / TRIG_MAX_RATIO),
+                s_watchface.center.y - (int)(cos_val * t / TRIG_MAX_RATIO));
+}
+
+static void check_point(ProjectionStats *stats, GPoint got, GPoint want) {
+  stats->checked++;
+  if (gpoint_equal(&got, &want)) return;
+  stats->mismatched++;
+  fprintf(stderr, "projection: got (%d, %d), want (%d, %d)\n", got.x, got.y, want.x, want.y);
+}
+#endif
+
+// Every marker angle at every inset from the face edge to past the hour
+// labels, plus each marker entry of the table
+static ProjectionStats check_projection(void) {
+  ProjectionStats stats = { 0, 0 };
+  #if defined(PBL_RECT)
+  int face_w = FACE_W_RADIUS - (CLOCK_FACE_STROKE_WIDTH / 2);
+  int face_h = FACE_H_RADIUS - (CLOCK_FACE_STROKE_WIDTH / 2);
+  for (int i = 0; i < MINUTE_MARKER_COUNT; i++) {
+    int32_t angle = degrees_to_trig_angle(i * 6);
+    for (int inset = 0; inset <= MAJOR_MARKER_LENGTH + NUMBER_OFFSET_FROM_MARKER; inset++) {
+      check_point(&stats, get_point_on_face(angle, face_w - inset, face_h - inset),
+                  reference_point(angle, face_w - inset, face_h - inset, SQR_WATCHFACE_RADIOUS));
+    }
+
+    int len = is_major_marker(i) ? MAJOR_MARKER_LENGTH : MINOR_MARKER_LENGTH;
+    check_point(&stats, s_face_geometry.marker_outer[i],
+                get_point_on_face(angle, face_w, face_h));
+    check_point(&stats, s_face_geometry.marker_inner[i],
+                get_point_on_face(angle, face_w - len, face_h - len));
+  }
+  #endif
+  return stats;
+}
+
+static void render_frame(Layer *root) {
+  host_frame_reset();
+  host_render(root);
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <out_dir>\n", argv[0]);
+    return 2;
+  }
+
+  setenv("TZ", "UTC0", 1);
+  tzset();
+  host_set_time(HOST_FIXED_TIME);
+
+  theme_init();
+  Window *window = host_window_create(GRect(0, 0, HOST_SCREEN_W, HOST_SCREEN_H));
+  Layer  *root   = window_get_root_layer(window);
+  GRect   bounds = layer_get_bounds(root);
+  label_layer(root, "root");
+
+  // Same order as main.c; the layout container is left out since the host
+  // has no unobstructed area to follow
+  watchface_geometry_init(bounds);
+  Layer *parent = root;
+  #if defined(WATCHFACE_COMPOSITOR)
+  parent = compositor_create(bounds, root);
+  label_layer(root->first_child, "compositor");
+  #endif
+  label_layer(face_layer_create(bounds, parent),    "face");
+  label_layer(date_layer_create(bounds, parent),    "date");
+  label_layer(hands_layer_create(bounds, parent),   "hands");
+  label_layer(seconds_layer_create(bounds, parent), "seconds");
+  label_layer(weather_layer_create(bounds, parent), "weather");
+
+  weather_forecast_set_packed(s_forecast, sizeof(s_forecast));
+  seconds_layer_set_visible(true);
+  host_run_timers();
+
+  static uint8_t rgb[HOST_SCREEN_W * HOST_SCREEN_H * 3];
+  char path[512];
+  bool ok = true;
+
+  ProjectionStats projection = check_projection();
+
+  printf("{\n");
+  printf("  \"projection\": {\"checked\": %d, \"mismatched\": %d},\n",
+         projection.checked, projection.mismatched);
+  render_frame(root);
+  print_frame_stats("cold", false);
+  host_frame_rgb(rgb);
+  snprintf(path, sizeof(path), "%s/cold.ppm", argv[1]);
+  ok &= write_ppm(path, rgb);
+
+  // The app fills the face cache from a deferred startup stage; the frame
+  // that captures it is not written, the one blitting from it is
+  face_layer_warm_cache();
+  render_frame(root);
+  render_frame(root);
+  print_frame_stats("warm", true);
+  printf("}\n");
+  host_frame_rgb(rgb);
+  snprintf(path, sizeof(path), "%s/warm.ppm", argv[1]);
+  ok &= write_ppm(path, rgb);
+  snprintf(path, sizeof(path), "%s/overdraw.pgm", argv[1]);
+  ok &= write_overdraw(path, host_overdraw());
+
+  if (!ok) fprintf(stderr, "host_render: could not write to %s\n", argv[1]);
+  return ok ? 0 : 1;
+}
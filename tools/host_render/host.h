@@ -0,0 +1,94 @@
+#pragma once
+#include <pebble.h>
+
+// Host-only side of the shim: the structs behind the opaque SDK types and
+// the hooks driver.c uses to render frames and read back the accounting.
+
+// ============================================================================
+// OPAQUE SDK TYPES
+// ============================================================================
+
+struct GBitmap {
+  GSize         size;
+  GBitmapFormat format;
+  uint16_t      stride;
+  uint8_t      *data;
+  GColor       *palette;
+  bool          free_palette;
+};
+
+struct Layer {
+  GRect            frame;
+  GRect            bounds;
+  bool             hidden;
+  LayerUpdateProc  update_proc;
+  Layer           *parent;
+  Layer           *first_child;
+  Layer           *next_sibling;
+  const char      *label;   // accounting bucket, inherited by children
+};
+
+struct Window {
+  Layer *root;
+};
+
+// ============================================================================
+// DRAW-CALL ACCOUNTING
+// ============================================================================
+
+typedef enum {
+  HostCallPixel = 0,
+  HostCallLine,        // stroke width 1
+  HostCallThickLine,   // stroke width > 1
+  HostCallCircle,
+  HostCallFillCircle,
+  HostCallRoundRect,
+  HostCallFillRect,
+  HostCallText,
+  HostCallPath,
+  HostCallBitmap,
+  HostCallCount,
+} HostCall;
+
+#define HOST_MAX_LABELS  12
+
+typedef struct {
+  const char *label;
+  uint32_t    calls[HostCallCount];
+  uint32_t    pixels[HostCallCount];  // pixel writes, overdraw included
+} HostLabelStats;
+
+const char* host_call_name(HostCall call);
+
+// ============================================================================
+// RASTERIZER (raster.c)
+// ============================================================================
+
+// Clears the frame buffer, overdraw counts and statistics
+void host_frame_reset(void);
+
+// Renders every visible layer under root, parents before children
+void host_render(Layer *root);
+
+// Per-label statistics of the last host_render
+int                   host_stats_count(void);
+const HostLabelStats* host_stats_get(int index);
+
+// Frame buffer as RGB888 and per-pixel write counts, both HOST_SCREEN_W x
+// HOST_SCREEN_H, row-major. Pixels outside a round display read as black
+void host_frame_rgb(uint8_t *rgb_out);
+const uint16_t* host_overdraw(void);
+
+// ============================================================================
+// SERVICES (pebble_host.c)
+// ============================================================================
+
+// Runs every registered AppTimer once, soonest first (the render scheduler
+// flush, mostly). Timers registered by the callbacks wait for the next call
+void host_run_timers(void);
+
+// Fixed instant host_time() reports
+void host_set_time(time_t now);
+
+// Lets driver.c build the window the modules expect
+Window* host_window_create(GRect bounds);
@@ -0,0 +1,337 @@
+#pragma once
+// Host stand-in for the Pebble SDK header, used only by tools/host_render.py.
+//
+// Declares just the SDK surface the rendering modules in src/c use, backed
+// by a small software rasterizer (raster.c) and in-memory services
+// (pebble_host.c). Drawing is aliased and text uses a built-in 5x7 font, so
+// images are close to, not identical with, the real firmware's output; what
+// they are is deterministic, which is what golden images and pixel counts
+// need.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// PLATFORM — host_render.py passes PBL_COLOR/PBL_BW, PBL_RECT/PBL_ROUND,
+// PBL_PLATFORM_<NAME> and the screen size
+// ============================================================================
+
+#if !defined(HOST_SCREEN_W) || !defined(HOST_SCREEN_H)
+#error "HOST_SCREEN_W and HOST_SCREEN_H must be defined"
+#endif
+
+#if defined(PBL_COLOR)
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_true)
+#else
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_false)
+#endif
+
+#if defined(PBL_ROUND)
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_true)
+#else
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_false)
+#endif
+
+#define ARRAY_LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+
+// ============================================================================
+// GEOMETRY AND COLOR
+// ============================================================================
+
+typedef struct { int16_t x, y; } GPoint;
+typedef struct { int16_t w, h; } GSize;
+typedef struct { GPoint origin; GSize size; } GRect;
+
+#define GPoint(x, y)        ((GPoint) { (int16_t)(x), (int16_t)(y) })
+#define GSize(w, h)         ((GSize)  { (int16_t)(w), (int16_t)(h) })
+#define GRect(x, y, w, h)   ((GRect)  { { (int16_t)(x), (int16_t)(y) }, { (int16_t)(w), (int16_t)(h) } })
+#define GPointZero          GPoint(0, 0)
+#define GRectZero           GRect(0, 0, 0, 0)
+
+bool   gpoint_equal(const GPoint *a, const GPoint *b);
+bool   grect_equal(const GRect *a, const GRect *b);
+void   grect_clip(GRect *rect, const GRect *clipper);
+GPoint grect_center_point(const GRect *rect);
+
+// 8-bit ARGB, two bits per channel — same layout as the firmware
+typedef union { uint8_t argb; } GColor8;
+typedef GColor8 GColor;
+
+#define GColorClearARGB8     ((uint8_t)0x00)
+#define GColorBlackARGB8     ((uint8_t)0xC0)
+#define GColorBlueARGB8      ((uint8_t)0xC3)
+#define GColorGreenARGB8     ((uint8_t)0xCC)
+#define GColorCyanARGB8      ((uint8_t)0xCF)
+#define GColorDarkGrayARGB8  ((uint8_t)0xD5)
+#define GColorLightGrayARGB8 ((uint8_t)0xEA)
+#define GColorRedARGB8       ((uint8_t)0xF0)
+#define GColorOrangeARGB8    ((uint8_t)0xF4)
+#define GColorYellowARGB8    ((uint8_t)0xFC)
+#define GColorWhiteARGB8     ((uint8_t)0xFF)
+
+#define GColorClear     ((GColor8) { .argb = GColorClearARGB8 })
+#define GColorBlack     ((GColor8) { .argb = GColorBlackARGB8 })
+#define GColorBlue      ((GColor8) { .argb = GColorBlueARGB8 })
+#define GColorGreen     ((GColor8) { .argb = GColorGreenARGB8 })
+#define GColorCyan      ((GColor8) { .argb = GColorCyanARGB8 })
+#define GColorDarkGray  ((GColor8) { .argb = GColorDarkGrayARGB8 })
+#define GColorLightGray ((GColor8) { .argb = GColorLightGrayARGB8 })
+#define GColorRed       ((GColor8) { .argb = GColorRedARGB8 })
+#define GColorOrange    ((GColor8) { .argb = GColorOrangeARGB8 })
+#define GColorYellow    ((GColor8) { .argb = GColorYellowARGB8 })
+#define GColorWhite     ((GColor8) { .argb = GColorWhiteARGB8 })
+
+bool gcolor_equal(GColor a, GColor b);
+
+// ============================================================================
+// TRIG — generated from libm, rounded, same as tools/geometry_tables.py
+// ============================================================================
+
+#define TRIG_MAX_ANGLE 0x10000
+#define TRIG_MAX_RATIO 0xffff
+
+int32_t sin_lookup(int32_t angle);
+int32_t cos_lookup(int32_t angle);
+
+// ============================================================================
+// BITMAPS
+// ============================================================================
+
+typedef enum {
+  GBitmapFormat1Bit = 0,
+  GBitmapFormat8Bit,
+  GBitmapFormat1BitPalette,
+  GBitmapFormat2BitPalette,
+  GBitmapFormat4BitPalette,
+  GBitmapFormat8BitCircular,
+} GBitmapFormat;
+
+typedef struct GBitmap GBitmap;
+
+typedef struct {
+  uint8_t *data;
+  int16_t  min_x;
+  int16_t  max_x;
+} GBitmapDataRowInfo;
+
+GBitmap*           gbitmap_create_blank(GSize size, GBitmapFormat format);
+GBitmap*           gbitmap_create_blank_with_palette(GSize size, GBitmapFormat format,
+                                                     GColor *palette, bool free_on_destroy);
+void               gbitmap_destroy(GBitmap *bitmap);
+uint8_t*           gbitmap_get_data(const GBitmap *bitmap);
+uint16_t           gbitmap_get_bytes_per_row(const GBitmap *bitmap);
+GBitmapFormat      gbitmap_get_format(const GBitmap *bitmap);
+GRect              gbitmap_get_bounds(const GBitmap *bitmap);
+GColor*            gbitmap_get_palette(const GBitmap *bitmap);
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap *bitmap, uint16_t y);
+
+// ============================================================================
+// GRAPHICS CONTEXT
+// ============================================================================
+
+typedef struct GContext GContext;
+typedef struct GFontInfo *GFont;
+
+typedef enum {
+  GCompOpAssign,
+  GCompOpAssignInverted,
+  GCompOpOr,
+  GCompOpAnd,
+  GCompOpClear,
+  GCompOpSet,
+} GCompOp;
+
+typedef enum {
+  GCornerNone        = 0,
+  GCornersAll        = 15,
+} GCornerMask;
+
+typedef enum {
+  GTextOverflowModeWordWrap,
+  GTextOverflowModeTrailingEllipsis,
+  GTextOverflowModeFill,
+} GTextOverflowMode;
+
+typedef enum {
+  GTextAlignmentLeft,
+  GTextAlignmentCenter,
+  GTextAlignmentRight,
+} GTextAlignment;
+
+typedef struct GTextAttributes GTextAttributes;
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_text_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t width);
+void graphics_context_set_antialiased(GContext *ctx, bool enable);
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode);
+
+void graphics_draw_pixel(GContext *ctx, GPoint point);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+void graphics_draw_circle(GContext *ctx, GPoint center, uint16_t radius);
+void graphics_fill_circle(GContext *ctx, GPoint center, uint16_t radius);
+void graphics_draw_round_rect(GContext *ctx, GRect rect, uint16_t radius);
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask mask);
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect);
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box,
+                        GTextOverflowMode overflow, GTextAlignment alignment,
+                        GTextAttributes *attributes);
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box,
+                                            GTextOverflowMode overflow, GTextAlignment alignment);
+
+GBitmap* graphics_capture_frame_buffer(GContext *ctx);
+bool     graphics_release_frame_buffer(GContext *ctx, GBitmap *buffer);
+
+#define FONT_KEY_GOTHIC_14                  "GOTHIC_14"
+#define FONT_KEY_GOTHIC_18_BOLD             "GOTHIC_18_BOLD"
+#define FONT_KEY_LECO_20_BOLD_NUMBERS       "LECO_20_BOLD_NUMBERS"
+#define FONT_KEY_LECO_26_BOLD_NUMBERS_AM_PM "LECO_26_BOLD_NUMBERS_AM_PM"
+
+GFont fonts_get_system_font(const char *font_key);
+
+// ============================================================================
+// PATHS
+// ============================================================================
+
+typedef struct {
+  uint32_t num_points;
+  GPoint  *points;
+} GPathInfo;
+
+// Public in the SDK as well: callers may repoint points / num_points
+typedef struct GPath {
+  uint32_t num_points;
+  GPoint  *points;
+  int32_t  rotation;
+  GPoint   offset;
+} GPath;
+
+GPath* gpath_create(const GPathInfo *init);
+void   gpath_destroy(GPath *path);
+void   gpath_rotate_to(GPath *path, int32_t angle);
+void   gpath_move_to(GPath *path, GPoint point);
+void   gpath_draw_filled(GContext *ctx, GPath *path);
+void   gpath_draw_outline_open(GContext *ctx, GPath *path);
+
+// ============================================================================
+// LAYERS AND WINDOWS
+// ============================================================================
+
+typedef struct Layer  Layer;
+typedef struct Window Window;
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+
+Layer*  layer_create(GRect frame);
+void    layer_destroy(Layer *layer);
+void    layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void    layer_add_child(Layer *parent, Layer *child);
+void    layer_mark_dirty(Layer *layer);
+GRect   layer_get_frame(const Layer *layer);
+void    layer_set_frame(Layer *layer, GRect frame);
+GRect   layer_get_bounds(const Layer *layer);
+GRect   layer_get_unobstructed_bounds(const Layer *layer);
+bool    layer_get_hidden(const Layer *layer);
+void    layer_set_hidden(Layer *layer, bool hidden);
+Layer*  layer_get_parent(const Layer *layer);
+Window* layer_get_window(const Layer *layer);
+Layer*  window_get_root_layer(const Window *window);
+
+// ============================================================================
+// SERVICES — in-memory stand-ins
+// ============================================================================
+
+typedef enum {
+  SECOND_UNIT = 1 << 0,
+  MINUTE_UNIT = 1 << 1,
+  HOUR_UNIT   = 1 << 2,
+  DAY_UNIT    = 1 << 3,
+  MONTH_UNIT  = 1 << 4,
+  YEAR_UNIT   = 1 << 5,
+} TimeUnits;
+
+typedef void (*TickHandler)(struct tm *tick_time, TimeUnits units_changed);
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler);
+void tick_timer_service_unsubscribe(void);
+
+typedef enum { ACCEL_AXIS_X, ACCEL_AXIS_Y, ACCEL_AXIS_Z } AccelAxisType;
+
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+AppTimer* app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *data);
+bool      app_timer_reschedule(AppTimer *timer, uint32_t new_timeout_ms);
+void      app_timer_cancel(AppTimer *timer);
+
+// The frame is rendered at a fixed instant, so golden images never change
+// with the wall clock
+time_t   host_time(time_t *tloc);
+#define  time(tloc) host_time(tloc)
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms);
+
+bool    persist_exists(uint32_t key);
+int32_t persist_read_int(uint32_t key);
+int     persist_write_int(uint32_t key, int32_t value);
+int     persist_read_data(uint32_t key, void *buffer, size_t length);
+int     persist_write_data(uint32_t key, const void *data, size_t length);
+int     persist_delete(uint32_t key);
+
+size_t heap_bytes_free(void);
+size_t heap_bytes_used(void);
+
+bool quiet_time_is_active(void);
+
+typedef enum {
+  HealthActivityNone         = 0,
+  HealthActivitySleep        = 1 << 0,
+  HealthActivityRestfulSleep = 1 << 1,
+} HealthActivityMask;
+typedef enum { HealthMetricStepCount = 0 } HealthMetric;
+typedef int32_t HealthValue;
+HealthActivityMask health_service_peek_current_activities(void);
+HealthValue        health_service_sum_today(HealthMetric metric);
+
+// battery_policy.c subscribes, but the host never delivers a change: full
+// charge, phone connected
+typedef struct {
+  uint8_t charge_percent;
+  bool    is_charging;
+  bool    is_plugged;
+} BatteryChargeState;
+typedef void (*BatteryStateHandler)(BatteryChargeState charge);
+void               battery_state_service_subscribe(BatteryStateHandler handler);
+void               battery_state_service_unsubscribe(void);
+BatteryChargeState battery_state_service_peek(void);
+
+typedef void (*ConnectionHandler)(bool connected);
+typedef struct {
+  ConnectionHandler pebble_app_connection_handler;
+  ConnectionHandler pebblekit_connection_handler;
+} ConnectionHandlers;
+void connection_service_subscribe(ConnectionHandlers handlers);
+void connection_service_unsubscribe(void);
+bool connection_service_peek_pebble_app_connection(void);
+
+// Named by profile.h's stubs only; nothing on the host sends or receives
+typedef struct DictionaryIterator DictionaryIterator;
+typedef enum {
+  APP_MSG_OK              = 0,
+  APP_MSG_BUSY            = 64,
+  APP_MSG_BUFFER_OVERFLOW = 128,
+  APP_MSG_OUT_OF_MEMORY   = 4096,
+} AppMessageResult;
+
+typedef enum {
+  APP_LOG_LEVEL_ERROR   = 1,
+  APP_LOG_LEVEL_WARNING = 50,
+  APP_LOG_LEVEL_INFO    = 100,
+  APP_LOG_LEVEL_DEBUG   = 200,
+} AppLogLevel;
+
+void app_log(uint8_t level, const char *file, int line, const char *fmt, ...)
+  __attribute__((format(printf, 4, 5)));
+#define APP_LOG(level, fmt, ...) app_log(level, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
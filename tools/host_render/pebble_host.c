@@ -0,0 +1,346 @@
+#include "host.h"
+#include <math.h>
+#include <stdarg.h>
+
+// In-memory stand-ins for the SDK services the rendering modules touch
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+#define HOST_MAX_TIMERS   16
+#define HOST_MAX_PERSIST  8
+#define HOST_PERSIST_SIZE 256
+
+struct AppTimer {
+  bool             active;
+  uint32_t         timeout_ms;
+  AppTimerCallback callback;
+  void            *data;
+};
+
+typedef struct {
+  bool     used;
+  uint32_t key;
+  size_t   length;
+  uint8_t  data[HOST_PERSIST_SIZE];
+} PersistSlot;
+
+static AppTimer    s_timers[HOST_MAX_TIMERS];
+static PersistSlot s_persist[HOST_MAX_PERSIST];
+static time_t      s_now;
+static size_t      s_heap_used;
+
+// ============================================================================
+// GEOMETRY AND COLOR
+// ============================================================================
+
+bool gpoint_equal(const GPoint *a, const GPoint *b) {
+  return a->x == b->x && a->y == b->y;
+}
+
+bool grect_equal(const GRect *a, const GRect *b) {
+  return gpoint_equal(&a->origin, &b->origin) && a->size.w == b->size.w && a->size.h == b->size.h;
+}
+
+void grect_clip(GRect *rect, const GRect *clipper) {
+  int x0 = rect->origin.x > clipper->origin.x ? rect->origin.x : clipper->origin.x;
+  int y0 = rect->origin.y > clipper->origin.y ? rect->origin.y : clipper->origin.y;
+  int x1 = rect->origin.x + rect->size.w;
+  int y1 = rect->origin.y + rect->size.h;
+  int cx1 = clipper->origin.x + clipper->size.w;
+  int cy1 = clipper->origin.y + clipper->size.h;
+  if (x1 > cx1) x1 = cx1;
+  if (y1 > cy1) y1 = cy1;
+  *rect = GRect(x0, y0, x1 > x0 ? x1 - x0 : 0, y1 > y0 ? y1 - y0 : 0);
+}
+
+GPoint grect_center_point(const GRect *rect) {
+  return GPoint(rect->origin.x + rect->size.w / 2, rect->origin.y + rect->size.h / 2);
+}
+
+bool gcolor_equal(GColor a, GColor b) {
+  return a.argb == b.argb;
+}
+
+int32_t sin_lookup(int32_t angle) {
+  return (int32_t)lround(sin(2 * M_PI * angle / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+int32_t cos_lookup(int32_t angle) {
+  return (int32_t)lround(cos(2 * M_PI * angle / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+// ============================================================================
+// BITMAPS
+// ============================================================================
+
+static uint16_t row_bytes(GSize size, GBitmapFormat format) {
+  switch (format) {
+    case GBitmapFormat1Bit:        return ((size.w + 31) / 32) * 4;
+    case GBitmapFormat1BitPalette: return (size.w + 7) / 8;
+    case GBitmapFormat2BitPalette: return (size.w + 3) / 4;
+    case GBitmapFormat4BitPalette: return (size.w + 1) / 2;
+    default:                       return size.w;
+  }
+}
+
+GBitmap* gbitmap_create_blank(GSize size, GBitmapFormat format) {
+  GBitmap *bitmap = calloc(1, sizeof(GBitmap));
+  bitmap->size   = size;
+  bitmap->format = format;
+  bitmap->stride = row_bytes(size, format);
+  bitmap->data   = calloc(size.h, bitmap->stride);
+  s_heap_used   += sizeof(GBitmap) + (size_t)size.h * bitmap->stride;
+  return bitmap;
+}
+
+GBitmap* gbitmap_create_blank_with_palette(GSize size, GBitmapFormat format,
+                                           GColor *palette, bool free_on_destroy) {
+  GBitmap *bitmap = gbitmap_create_blank(size, format);
+  bitmap->palette      = palette;
+  bitmap->free_palette = free_on_destroy;
+  return bitmap;
+}
+
+void gbitmap_destroy(GBitmap *bitmap) {
+  s_heap_used -= sizeof(GBitmap) + (size_t)bitmap->size.h * bitmap->stride;
+  if (bitmap->free_palette) free(bitmap->palette);
+  free(bitmap->data);
+  free(bitmap);
+}
+
+uint8_t*      gbitmap_get_data(const GBitmap *bitmap)          { return bitmap->data; }
+uint16_t      gbitmap_get_bytes_per_row(const GBitmap *bitmap) { return bitmap->stride; }
+GBitmapFormat gbitmap_get_format(const GBitmap *bitmap)        { return bitmap->format; }
+GColor*       gbitmap_get_palette(const GBitmap *bitmap)       { return bitmap->palette; }
+
+GRect gbitmap_get_bounds(const GBitmap *bitmap) {
+  return GRect(0, 0, bitmap->size.w, bitmap->size.h);
+}
+
+// Circular bitmaps (the round frame buffer) only hold the visible span of
+// each row; data is still indexed by absolute x
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap *bitmap, uint16_t y) {
+  GBitmapDataRowInfo info = { bitmap->data + y * bitmap->stride, 0, bitmap->size.w - 1 };
+  if (bitmap->format == GBitmapFormat8BitCircular) {
+    double r  = bitmap->size.w / 2.0;
+    double dy = y + 0.5 - bitmap->size.h / 2.0;
+    double hw = dy * dy < r * r ? sqrt(r * r - dy * dy) : 0;
+    info.min_x = (int16_t)ceil(r - hw - 0.5);
+    info.max_x = (int16_t)floor(r + hw - 0.5);
+  }
+  return info;
+}
+
+// ============================================================================
+// LAYERS AND WINDOWS
+// ============================================================================
+
+Layer* layer_create(GRect frame) {
+  Layer *layer = calloc(1, sizeof(Layer));
+  layer->frame  = frame;
+  layer->bounds = GRect(0, 0, frame.size.w, frame.size.h);
+  return layer;
+}
+
+static void remove_from_parent(Layer *layer) {
+  if (!layer->parent) return;
+  for (Layer **link = &layer->parent->first_child; *link; link = &(*link)->next_sibling) {
+    if (*link == layer) {
+      *link = layer->next_sibling;
+      break;
+    }
+  }
+  layer->parent       = NULL;
+  layer->next_sibling = NULL;
+}
+
+void layer_destroy(Layer *layer) {
+  if (!layer) return;
+  remove_from_parent(layer);
+  for (Layer *child = layer->first_child; child; child = child->next_sibling) child->parent = NULL;
+  free(layer);
+}
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+  layer->update_proc = update_proc;
+}
+
+void layer_add_child(Layer *parent, Layer *child) {
+  remove_from_parent(child);
+  Layer **link = &parent->first_child;
+  while (*link) link = &(*link)->next_sibling;
+  *link = child;
+  child->parent = parent;
+}
+
+// Every host_render redraws the whole tree, so dirtiness is not tracked
+void layer_mark_dirty(Layer *layer) { }
+
+GRect layer_get_frame(const Layer *layer)   { return layer->frame; }
+GRect layer_get_bounds(const Layer *layer)  { return layer->bounds; }
+bool  layer_get_hidden(const Layer *layer)  { return layer->hidden; }
+void  layer_set_hidden(Layer *layer, bool hidden) { layer->hidden = hidden; }
+Layer* layer_get_parent(const Layer *layer) { return layer->parent; }
+
+GRect layer_get_unobstructed_bounds(const Layer *layer) {
+  return layer->bounds;
+}
+
+void layer_set_frame(Layer *layer, GRect frame) {
+  layer->frame       = frame;
+  layer->bounds.size = frame.size;
+}
+
+static Window s_window;
+
+Window* host_window_create(GRect bounds) {
+  s_window.root = layer_create(bounds);
+  return &s_window;
+}
+
+Window* layer_get_window(const Layer *layer) {
+  return &s_window;
+}
+
+Layer* window_get_root_layer(const Window *window) {
+  return window->root;
+}
+
+// ============================================================================
+// TIMERS AND TIME
+// ============================================================================
+
+AppTimer* app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *data) {
+  for (int i = 0; i < HOST_MAX_TIMERS; i++) {
+    if (s_timers[i].active) continue;
+    s_timers[i] = (AppTimer) { true, timeout_ms, callback, data };
+    return &s_timers[i];
+  }
+  return NULL;
+}
+
+bool app_timer_reschedule(AppTimer *timer, uint32_t new_timeout_ms) {
+  if (!timer || !timer->active) return false;
+  timer->timeout_ms = new_timeout_ms;
+  return true;
+}
+
+void app_timer_cancel(AppTimer *timer) {
+  if (timer) timer->active = false;
+}
+
+void host_run_timers(void) {
+  AppTimer due[HOST_MAX_TIMERS];
+  int      n = 0;
+  for (int i = 0; i < HOST_MAX_TIMERS; i++) {
+    if (!s_timers[i].active) continue;
+    due[n++] = s_timers[i];
+    s_timers[i].active = false;
+  }
+  for (int a = 1; a < n; a++) {
+    for (int b = a; b > 0 && due[b - 1].timeout_ms > due[b].timeout_ms; b--) {
+      AppTimer t = due[b]; due[b] = due[b - 1]; due[b - 1] = t;
+    }
+  }
+  for (int i = 0; i < n; i++) due[i].callback(due[i].data);
+}
+
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler) { }
+void tick_timer_service_unsubscribe(void) { }
+
+void host_set_time(time_t now) {
+  s_now = now;
+}
+
+time_t host_time(time_t *tloc) {
+  if (tloc) *tloc = s_now;
+  return s_now;
+}
+
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms) {
+  if (tloc)   *tloc   = s_now;
+  if (out_ms) *out_ms = 0;
+  return 0;
+}
+
+// ============================================================================
+// PERSISTENCE, HEAP, HEALTH, BATTERY, LOGGING
+// ============================================================================
+
+static PersistSlot* find_persist(uint32_t key, bool create) {
+  for (int i = 0; i < HOST_MAX_PERSIST; i++) {
+    if (s_persist[i].used && s_persist[i].key == key) return &s_persist[i];
+  }
+  if (!create) return NULL;
+  for (int i = 0; i < HOST_MAX_PERSIST; i++) {
+    if (s_persist[i].used) continue;
+    s_persist[i].used = true;
+    s_persist[i].key  = key;
+    return &s_persist[i];
+  }
+  return NULL;
+}
+
+bool persist_exists(uint32_t key) {
+  return find_persist(key, false) != NULL;
+}
+
+int persist_write_data(uint32_t key, const void *data, size_t length) {
+  PersistSlot *slot = find_persist(key, true);
+  if (!slot || length > HOST_PERSIST_SIZE) return -1;
+  memcpy(slot->data, data, length);
+  slot->length = length;
+  return (int)length;
+}
+
+int persist_read_data(uint32_t key, void *buffer, size_t length) {
+  PersistSlot *slot = find_persist(key, false);
+  if (!slot) return -1;
+  size_t n = slot->length < length ? slot->length : length;
+  memcpy(buffer, slot->data, n);
+  return (int)n;
+}
+
+int persist_delete(uint32_t key) {
+  PersistSlot *slot = find_persist(key, false);
+  if (!slot) return -1;
+  slot->used = false;
+  return 0;
+}
+
+int persist_write_int(uint32_t key, int32_t value) {
+  return persist_write_data(key, &value, sizeof(value));
+}
+
+int32_t persist_read_int(uint32_t key) {
+  int32_t value = 0;
+  persist_read_data(key, &value, sizeof(value));
+  return value;
+}
+
+// Aplite's app heap, minus nothing — the host only tracks its own bitmaps
+size_t heap_bytes_used(void) { return s_heap_used; }
+size_t heap_bytes_free(void) { return 24 * 1024 - s_heap_used; }
+
+bool quiet_time_is_active(void) { return false; }
+HealthActivityMask health_service_peek_current_activities(void) { return HealthActivityNone; }
+HealthValue health_service_sum_today(HealthMetric metric) { return 0; }
+
+void battery_state_service_subscribe(BatteryStateHandler handler) { }
+void battery_state_service_unsubscribe(void) { }
+BatteryChargeState battery_state_service_peek(void) { return (BatteryChargeState) { 100, false, false }; }
+
+void connection_service_subscribe(ConnectionHandlers handlers) { }
+void connection_service_unsubscribe(void) { }
+bool connection_service_peek_pebble_app_connection(void) { return true; }
+
+void app_log(uint8_t level, const char *file, int line, const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "[%s:%d] ", file, line);
+  vfprintf(stderr, fmt, args);
+  fputc('\n', stderr);
+  va_end(args);
+}
@@ -0,0 +1,608 @@
+#include "host.h"
+#include <math.h>
+
+// Software rasterizer behind the GContext calls. Every pixel write goes
+// through put_pixel, which clips, applies the display's bit depth, bumps the
+// overdraw count and charges the write to the current call and layer label.
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+struct GContext {
+  GBitmap *fb;
+  GPoint   origin;        // current layer's drawing origin, screen coordinates
+  GRect    clip;          // screen coordinates
+  GColor   stroke_color;
+  GColor   fill_color;
+  GColor   text_color;
+  uint8_t  stroke_width;
+  GCompOp  comp_op;
+  bool     antialiased;   // recorded only — drawing is always aliased
+  int      label;         // index into s_stats
+  HostCall call;          // primitive currently writing pixels
+};
+
+struct GFontInfo {
+  const char *key;
+  int         scale;      // 5x7 glyphs are scaled by this
+  int         line_height;
+};
+
+static GBitmap        s_frame_buffer;
+static uint8_t        s_frame_data[HOST_SCREEN_H * (HOST_SCREEN_W + 3)];
+static uint16_t       s_overdraw[HOST_SCREEN_W * HOST_SCREEN_H];
+static HostLabelStats s_stats[HOST_MAX_LABELS];
+static int            s_stats_count;
+static GContext       s_ctx;
+
+static struct GFontInfo s_fonts[] = {
+  { FONT_KEY_GOTHIC_14,                  1, 14 },
+  { FONT_KEY_GOTHIC_18_BOLD,             2, 18 },
+  { FONT_KEY_LECO_20_BOLD_NUMBERS,       2, 20 },
+  { FONT_KEY_LECO_26_BOLD_NUMBERS_AM_PM, 3, 26 },
+};
+
+// ============================================================================
+// PRIVATE: 5x7 FONT — rows top to bottom, bit 4 is the leftmost column
+// ============================================================================
+
+typedef struct { uint32_t codepoint; uint8_t rows[7]; } Glyph;
+
+static const Glyph GLYPHS[] = {
+  { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+  { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+  { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+  { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+  { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+  { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+  { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+  { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+  { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+  { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+  { 'A', { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+  { 'B', { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E } },
+  { 'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+  { 'D', { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } },
+  { 'E', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } },
+  { 'F', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 } },
+  { 'G', { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F } },
+  { 'H', { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+  { 'I', { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+  { 'J', { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C } },
+  { 'K', { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+  { 'L', { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F } },
+  { 'M', { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } },
+  { 'N', { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+  { 'O', { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+  { 'P', { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+  { 'Q', { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D } },
+  { 'R', { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+  { 'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+  { 'T', { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+  { 'U', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+  { 'V', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+  { 'W', { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A } },
+  { 'X', { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 } },
+  { 'Y', { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 } },
+  { 'Z', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F } },
+  { '-', { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 } },
+  { '.', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C } },
+  { ':', { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 } },
+  { '?', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 } },
+  { 0xB0, { 0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00 } },  // degree sign
+  { ' ', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+};
+
+static const Glyph* find_glyph(uint32_t codepoint) {
+  for (unsigned i = 0; i < ARRAY_LENGTH(GLYPHS); i++) {
+    if (GLYPHS[i].codepoint == codepoint) return &GLYPHS[i];
+  }
+  return NULL;  // drawn as a solid box so unknown characters still cost pixels
+}
+
+// Decodes one UTF-8 sequence (the face only uses ASCII and U+00B0)
+static uint32_t next_codepoint(const char **text) {
+  const uint8_t *s = (const uint8_t *)*text;
+  uint32_t cp;
+  if (s[0] < 0x80)                { cp = s[0];                                *text += 1; }
+  else if ((s[0] & 0xE0) == 0xC0) { cp = ((s[0] & 0x1F) << 6) | (s[1] & 0x3F); *text += 2; }
+  else if ((s[0] & 0xF0) == 0xE0) { cp = '?';                                 *text += 3; }
+  else                            { cp = '?';                                 *text += 4; }
+  return cp;
+}
+
+// ============================================================================
+// PRIVATE: PIXELS
+// ============================================================================
+
+static bool on_display(int x, int y) {
+  if (x < 0 || y < 0 || x >= HOST_SCREEN_W || y >= HOST_SCREEN_H) return false;
+  #if defined(PBL_ROUND)
+  GBitmapDataRowInfo row = gbitmap_get_data_row_info(&s_frame_buffer, y);
+  if (x < row.min_x || x > row.max_x) return false;
+  #endif
+  return true;
+}
+
+static bool color_is_light(GColor c) {
+  int r = (c.argb >> 4) & 3, g = (c.argb >> 2) & 3, b = c.argb & 3;
+  return r + g + b >= 5;
+}
+
+static GColor read_pixel(int x, int y) {
+  #if defined(PBL_BW)
+  bool white = s_frame_data[y * s_frame_buffer.stride + x / 8] & (1 << (x % 8));
+  return white ? GColorWhite : GColorBlack;
+  #else
+  return (GColor) { .argb = s_frame_data[y * s_frame_buffer.stride + x] };
+  #endif
+}
+
+static void write_pixel(int x, int y, GColor c) {
+  #if defined(PBL_BW)
+  uint8_t *byte = &s_frame_data[y * s_frame_buffer.stride + x / 8];
+  if (color_is_light(c)) *byte |=  (1 << (x % 8));
+  else                   *byte &= ~(1 << (x % 8));
+  #else
+  s_frame_data[y * s_frame_buffer.stride + x] = c.argb | 0xC0;
+  #endif
+}
+
+// x, y in screen coordinates
+static void put_pixel(GContext *ctx, int x, int y, GColor c) {
+  if ((c.argb & 0xC0) == 0) return;  // fully transparent draws nothing
+  if (x < ctx->clip.origin.x || y < ctx->clip.origin.y ||
+      x >= ctx->clip.origin.x + ctx->clip.size.w || y >= ctx->clip.origin.y + ctx->clip.size.h) return;
+  if (!on_display(x, y)) return;
+
+  write_pixel(x, y, c);
+  s_overdraw[y * HOST_SCREEN_W + x]++;
+  s_stats[ctx->label].pixels[ctx->call]++;
+}
+
+static void begin_call(GContext *ctx, HostCall call) {
+  ctx->call = call;
+  s_stats[ctx->label].calls[call]++;
+}
+
+// Every pixel of the layer-local bounding box [x0, x1] x [y0, y1] whose
+// center passes inside() is filled with c
+typedef bool (*Coverage)(const void *shape, double x, double y);
+
+static void fill_coverage(GContext *ctx, int x0, int y0, int x1, int y1,
+                          Coverage inside, const void *shape, GColor c) {
+  for (int y = y0; y <= y1; y++) {
+    for (int x = x0; x <= x1; x++) {
+      if (inside(shape, x, y)) put_pixel(ctx, ctx->origin.x + x, ctx->origin.y + y, c);
+    }
+  }
+}
+
+// ============================================================================
+// PRIVATE: SHAPES
+// ============================================================================
+
+typedef struct { double ax, ay, bx, by, r; } Capsule;
+
+static bool inside_capsule(const void *shape, double x, double y) {
+  const Capsule *s = shape;
+  double dx = s->bx - s->ax, dy = s->by - s->ay;
+  double len2 = dx * dx + dy * dy;
+  double t = len2 > 0 ? ((x - s->ax) * dx + (y - s->ay) * dy) / len2 : 0;
+  if (t < 0) t = 0;
+  if (t > 1) t = 1;
+  double px = s->ax + t * dx - x, py = s->ay + t * dy - y;
+  return px * px + py * py <= s->r * s->r;
+}
+
+typedef struct { double cx, cy, r_in, r_out; } Ring;
+
+static bool inside_ring(const void *shape, double x, double y) {
+  const Ring *s = shape;
+  double d2 = (x - s->cx) * (x - s->cx) + (y - s->cy) * (y - s->cy);
+  return d2 >= s->r_in * s->r_in && d2 <= s->r_out * s->r_out;
+}
+
+// Signed distance to a rounded rect; stroke covers |d| <= half_width
+typedef struct { double cx, cy, hx, hy, radius, half_width; bool fill; } RoundBox;
+
+static bool inside_round_box(const void *shape, double x, double y) {
+  const RoundBox *s = shape;
+  double qx = fabs(x - s->cx) - (s->hx - s->radius);
+  double qy = fabs(y - s->cy) - (s->hy - s->radius);
+  double ox = qx > 0 ? qx : 0, oy = qy > 0 ? qy : 0;
+  double d  = sqrt(ox * ox + oy * oy) + fmin(fmax(qx, qy), 0) - s->radius;
+  return s->fill ? d <= 0.0 : fabs(d) <= s->half_width;
+}
+
+static void draw_thin_line(GContext *ctx, GPoint p0, GPoint p1, GColor c) {
+  int x0 = p0.x, y0 = p0.y, x1 = p1.x, y1 = p1.y;
+  int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+  int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+  for (;;) {
+    put_pixel(ctx, ctx->origin.x + x0, ctx->origin.y + y0, c);
+    if (x0 == x1 && y0 == y1) break;
+    int e2 = 2 * err;
+    if (e2 >= dy) { err += dy; x0 += sx; }
+    if (e2 <= dx) { err += dx; y0 += sy; }
+  }
+}
+
+// ============================================================================
+// GCONTEXT STATE
+// ============================================================================
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color)   { ctx->stroke_color = color; }
+void graphics_context_set_fill_color(GContext *ctx, GColor color)     { ctx->fill_color = color; }
+void graphics_context_set_text_color(GContext *ctx, GColor color)     { ctx->text_color = color; }
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t width)  { ctx->stroke_width = width ? width : 1; }
+void graphics_context_set_antialiased(GContext *ctx, bool enable)     { ctx->antialiased = enable; }
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp op) { ctx->comp_op = op; }
+
+// ============================================================================
+// PRIMITIVES
+// ============================================================================
+
+void graphics_draw_pixel(GContext *ctx, GPoint point) {
+  begin_call(ctx, HostCallPixel);
+  put_pixel(ctx, ctx->origin.x + point.x, ctx->origin.y + point.y, ctx->stroke_color);
+}
+
+// One stroke in the current color and width, with round caps when thick
+static void stroke_segment(GContext *ctx, GPoint p0, GPoint p1) {
+  if (ctx->stroke_width <= 1) {
+    draw_thin_line(ctx, p0, p1, ctx->stroke_color);
+    return;
+  }
+  Capsule s = { p0.x, p0.y, p1.x, p1.y, ctx->stroke_width / 2.0 };
+  int pad = ctx->stroke_width / 2 + 1;
+  fill_coverage(ctx, (p0.x < p1.x ? p0.x : p1.x) - pad, (p0.y < p1.y ? p0.y : p1.y) - pad,
+                     (p0.x > p1.x ? p0.x : p1.x) + pad, (p0.y > p1.y ? p0.y : p1.y) + pad,
+                inside_capsule, &s, ctx->stroke_color);
+}
+
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) {
+  begin_call(ctx, ctx->stroke_width <= 1 ? HostCallLine : HostCallThickLine);
+  stroke_segment(ctx, p0, p1);
+}
+
+void graphics_draw_circle(GContext *ctx, GPoint center, uint16_t radius) {
+  begin_call(ctx, HostCallCircle);
+  double half = ctx->stroke_width / 2.0;
+  if (half < 0.5) half = 0.5;
+  Ring s = { center.x, center.y, radius - half, radius + half };
+  int pad = radius + ctx->stroke_width;
+  fill_coverage(ctx, center.x - pad, center.y - pad, center.x + pad, center.y + pad,
+                inside_ring, &s, ctx->stroke_color);
+}
+
+void graphics_fill_circle(GContext *ctx, GPoint center, uint16_t radius) {
+  begin_call(ctx, HostCallFillCircle);
+  Ring s = { center.x, center.y, 0, radius + 0.5 };
+  fill_coverage(ctx, center.x - radius, center.y - radius, center.x + radius, center.y + radius,
+                inside_ring, &s, ctx->fill_color);
+}
+
+void graphics_draw_round_rect(GContext *ctx, GRect rect, uint16_t radius) {
+  begin_call(ctx, HostCallRoundRect);
+  double half = ctx->stroke_width / 2.0;
+  if (half < 0.5) half = 0.5;
+  RoundBox s = {
+    rect.origin.x + (rect.size.w - 1) / 2.0, rect.origin.y + (rect.size.h - 1) / 2.0,
+    (rect.size.w - 1) / 2.0, (rect.size.h - 1) / 2.0, radius, half, false,
+  };
+  int pad = ctx->stroke_width + 1;
+  fill_coverage(ctx, rect.origin.x - pad, rect.origin.y - pad,
+                rect.origin.x + rect.size.w + pad, rect.origin.y + rect.size.h + pad,
+                inside_round_box, &s, ctx->stroke_color);
+}
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask mask) {
+  begin_call(ctx, HostCallFillRect);
+  RoundBox s = {
+    rect.origin.x + (rect.size.w - 1) / 2.0, rect.origin.y + (rect.size.h - 1) / 2.0,
+    (rect.size.w - 1) / 2.0, (rect.size.h - 1) / 2.0,
+    mask == GCornerNone ? 0 : corner_radius, 0, true,
+  };
+  fill_coverage(ctx, rect.origin.x, rect.origin.y,
+                rect.origin.x + rect.size.w - 1, rect.origin.y + rect.size.h - 1,
+                inside_round_box, &s, ctx->fill_color);
+}
+
+// ============================================================================
+// TEXT
+// ============================================================================
+
+GFont fonts_get_system_font(const char *font_key) {
+  for (unsigned i = 0; i < ARRAY_LENGTH(s_fonts); i++) {
+    if (strcmp(s_fonts[i].key, font_key) == 0) return &s_fonts[i];
+  }
+  return &s_fonts[0];
+}
+
+static int text_width(const char *text, GFont font) {
+  int n = 0;
+  while (*text) { next_codepoint(&text); n++; }
+  return n ? n * 6 * font->scale - font->scale : 0;
+}
+
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box,
+                                            GTextOverflowMode overflow, GTextAlignment alignment) {
+  int w = text_width(text, font);
+  return GSize(w < box.size.w ? w : box.size.w, font->line_height);
+}
+
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box,
+                        GTextOverflowMode overflow, GTextAlignment alignment,
+                        GTextAttributes *attributes) {
+  begin_call(ctx, HostCallText);
+  int s = font->scale;
+  int w = text_width(text, font);
+  int x = box.origin.x;
+  if (alignment == GTextAlignmentCenter) x += (box.size.w - w) / 2;
+  if (alignment == GTextAlignmentRight)  x += box.size.w - w;
+  int y = box.origin.y + (font->line_height - 7 * s) / 2;
+
+  // Text is clipped to its box like the firmware does
+  GRect saved = ctx->clip;
+  GRect clip  = GRect(ctx->origin.x + box.origin.x, ctx->origin.y + box.origin.y,
+                      box.size.w, box.size.h);
+  grect_clip(&clip, &saved);
+  ctx->clip = clip;
+
+  while (*text) {
+    const Glyph *g = find_glyph(next_codepoint(&text));
+    for (int row = 0; row < 7 * s; row++) {
+      for (int col = 0; col < 5 * s; col++) {
+        bool on = g ? (g->rows[row / s] >> (4 - col / s)) & 1 : true;
+        if (on) put_pixel(ctx, ctx->origin.x + x + col, ctx->origin.y + y + row, ctx->text_color);
+      }
+    }
+    x += 6 * s;
+  }
+  ctx->clip = saved;
+}
+
+// ============================================================================
+// PATHS — rotate about (0,0), then offset, like the firmware
+// ============================================================================
+
+GPath* gpath_create(const GPathInfo *init) {
+  GPath *path = calloc(1, sizeof(GPath));
+  path->num_points = init->num_points;
+  path->points     = init->points;
+  return path;
+}
+
+void gpath_destroy(GPath *path)                  { free(path); }
+void gpath_rotate_to(GPath *path, int32_t angle) { path->rotation = angle; }
+void gpath_move_to(GPath *path, GPoint point)    { path->offset = point; }
+
+static GPoint path_point(const GPath *path, int i, int32_t s, int32_t c) {
+  GPoint p = path->points[i];
+  return GPoint((p.x * c - p.y * s) / TRIG_MAX_RATIO + path->offset.x,
+                (p.x * s + p.y * c) / TRIG_MAX_RATIO + path->offset.y);
+}
+
+void gpath_draw_outline_open(GContext *ctx, GPath *path) {
+  begin_call(ctx, HostCallPath);
+  int32_t s = sin_lookup(path->rotation), c = cos_lookup(path->rotation);
+  for (uint32_t i = 1; i < path->num_points; i++) {
+    stroke_segment(ctx, path_point(path, i - 1, s, c), path_point(path, i, s, c));
+  }
+}
+
+void gpath_draw_filled(GContext *ctx, GPath *path) {
+  begin_call(ctx, HostCallPath);
+  if (path->num_points < 3 || path->num_points > 64) return;
+
+  int32_t s = sin_lookup(path->rotation), c = cos_lookup(path->rotation);
+  double  px[64], py[64];
+  double  min_y = 1e9, max_y = -1e9;
+  for (uint32_t i = 0; i < path->num_points; i++) {
+    GPoint p = path->points[i];
+    px[i] = (p.x * c - p.y * s) / TRIG_MAX_RATIO + path->offset.x;
+    py[i] = (p.x * s + p.y * c) / TRIG_MAX_RATIO + path->offset.y;
+    if (py[i] < min_y) min_y = py[i];
+    if (py[i] > max_y) max_y = py[i];
+  }
+
+  // Even-odd scanline fill sampled at pixel centers
+  for (int y = (int)floor(min_y); y <= (int)ceil(max_y); y++) {
+    double xs[64];
+    int    n = 0;
+    for (uint32_t i = 0; i < path->num_points; i++) {
+      uint32_t j = (i + 1) % path->num_points;
+      if ((py[i] <= y && py[j] > y) || (py[j] <= y && py[i] > y)) {
+        xs[n++] = px[i] + (y - py[i]) * (px[j] - px[i]) / (py[j] - py[i]);
+      }
+    }
+    for (int a = 1; a < n; a++) {
+      for (int b = a; b > 0 && xs[b - 1] > xs[b]; b--) {
+        double t = xs[b]; xs[b] = xs[b - 1]; xs[b - 1] = t;
+      }
+    }
+    for (int k = 0; k + 1 < n; k += 2) {
+      for (int x = (int)ceil(xs[k]); x <= (int)floor(xs[k + 1]); x++) {
+        put_pixel(ctx, ctx->origin.x + x, ctx->origin.y + y, ctx->fill_color);
+      }
+    }
+  }
+}
+
+// ============================================================================
+// BITMAPS
+// ============================================================================
+
+static int palette_bits(GBitmapFormat format) {
+  switch (format) {
+    case GBitmapFormat1BitPalette: return 1;
+    case GBitmapFormat2BitPalette: return 2;
+    case GBitmapFormat4BitPalette: return 4;
+    default:                       return 0;
+  }
+}
+
+static GColor bitmap_pixel(const GBitmap *bitmap, int x, int y) {
+  const uint8_t *row  = bitmap->data + y * bitmap->stride;
+  int            bits = palette_bits(bitmap->format);
+  if (bits) {
+    int per_byte = 8 / bits;
+    int index = (row[x / per_byte] >> (8 - bits * (x % per_byte + 1))) & ((1 << bits) - 1);
+    return bitmap->palette[index];
+  }
+  if (bitmap->format == GBitmapFormat1Bit) {
+    return (row[x / 8] & (1 << (x % 8))) ? GColorWhite : GColorBlack;
+  }
+  return (GColor) { .argb = row[x] };
+}
+
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect) {
+  begin_call(ctx, HostCallBitmap);
+  int w = rect.size.w < bitmap->size.w ? rect.size.w : bitmap->size.w;
+  int h = rect.size.h < bitmap->size.h ? rect.size.h : bitmap->size.h;
+
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      int    sx  = ctx->origin.x + rect.origin.x + x;
+      int    sy  = ctx->origin.y + rect.origin.y + y;
+      GColor src = bitmap_pixel(bitmap, x, y);
+      if (!on_display(sx, sy)) continue;
+
+      switch (ctx->comp_op) {
+        case GCompOpSet:
+          // Color: alpha blend (all-or-nothing here); B&W: only white pixels land
+          if (PBL_IF_COLOR_ELSE((src.argb & 0xC0) == 0, !color_is_light(src))) continue;
+          put_pixel(ctx, sx, sy, src);
+          break;
+        case GCompOpOr:
+          if (!color_is_light(src)) continue;
+          put_pixel(ctx, sx, sy, (GColor) { .argb = read_pixel(sx, sy).argb | src.argb });
+          break;
+        case GCompOpAnd:
+          put_pixel(ctx, sx, sy, (GColor) { .argb = read_pixel(sx, sy).argb & src.argb });
+          break;
+        case GCompOpClear:
+          if (!color_is_light(src)) continue;
+          put_pixel(ctx, sx, sy, GColorBlack);
+          break;
+        case GCompOpAssignInverted:
+          put_pixel(ctx, sx, sy, (GColor) { .argb = (uint8_t)(~src.argb | 0xC0) });
+          break;
+        case GCompOpAssign:
+        default:
+          put_pixel(ctx, sx, sy, (GColor) { .argb = src.argb | 0xC0 });
+          break;
+      }
+    }
+  }
+}
+
+GBitmap* graphics_capture_frame_buffer(GContext *ctx) {
+  return ctx->fb;
+}
+
+bool graphics_release_frame_buffer(GContext *ctx, GBitmap *buffer) {
+  return buffer == ctx->fb;
+}
+
+// ============================================================================
+// FRAME RENDERING
+// ============================================================================
+
+static int label_index(const char *label) {
+  for (int i = 0; i < s_stats_count; i++) {
+    if (strcmp(s_stats[i].label, label) == 0) return i;
+  }
+  if (s_stats_count == HOST_MAX_LABELS) return HOST_MAX_LABELS - 1;
+  s_stats[s_stats_count].label = label;
+  return s_stats_count++;
+}
+
+// Graphics state is reset before every update proc, as on the watch
+static void render_layer(Layer *layer, GPoint parent_origin, GRect parent_clip,
+                         const char *label) {
+  if (layer->hidden) return;
+  if (layer->label) label = layer->label;
+
+  GPoint origin = GPoint(parent_origin.x + layer->frame.origin.x + layer->bounds.origin.x,
+                         parent_origin.y + layer->frame.origin.y + layer->bounds.origin.y);
+  GRect  clip   = GRect(parent_origin.x + layer->frame.origin.x,
+                        parent_origin.y + layer->frame.origin.y,
+                        layer->frame.size.w, layer->frame.size.h);
+  grect_clip(&clip, &parent_clip);
+
+  if (layer->update_proc) {
+    s_ctx = (GContext) {
+      .fb           = &s_frame_buffer,
+      .origin       = origin,
+      .clip         = clip,
+      .stroke_color = GColorBlack,
+      .fill_color   = GColorBlack,
+      .text_color   = GColorWhite,
+      .stroke_width = 1,
+      .comp_op      = GCompOpAssign,
+      .antialiased  = true,
+      .label        = label_index(label),
+    };
+    layer->update_proc(layer, &s_ctx);
+  }
+
+  for (Layer *child = layer->first_child; child; child = child->next_sibling) {
+    render_layer(child, origin, clip, label);
+  }
+}
+
+void host_frame_reset(void) {
+  s_frame_buffer = (GBitmap) {
+    .size   = GSize(HOST_SCREEN_W, HOST_SCREEN_H),
+    .format = PBL_IF_COLOR_ELSE(PBL_IF_ROUND_ELSE(GBitmapFormat8BitCircular, GBitmapFormat8Bit),
+                                GBitmapFormat1Bit),
+    .stride = PBL_IF_COLOR_ELSE(HOST_SCREEN_W, ((HOST_SCREEN_W + 31) / 32) * 4),
+    .data   = s_frame_data,
+  };
+  // The window background is black
+  memset(s_frame_data, PBL_IF_COLOR_ELSE(GColorBlackARGB8, 0x00), sizeof(s_frame_data));
+  memset(s_overdraw, 0, sizeof(s_overdraw));
+  memset(s_stats, 0, sizeof(s_stats));
+  s_stats_count = 0;
+}
+
+void host_render(Layer *root) {
+  host_frame_reset();
+  render_layer(root, GPointZero, GRect(0, 0, HOST_SCREEN_W, HOST_SCREEN_H), "other");
+}
+
+int host_stats_count(void) {
+  return s_stats_count;
+}
+
+const HostLabelStats* host_stats_get(int index) {
+  return &s_stats[index];
+}
+
+const uint16_t* host_overdraw(void) {
+  return s_overdraw;
+}
+
+void host_frame_rgb(uint8_t *rgb_out) {
+  for (int y = 0; y < HOST_SCREEN_H; y++) {
+    for (int x = 0; x < HOST_SCREEN_W; x++) {
+      uint8_t *px = &rgb_out[(y * HOST_SCREEN_W + x) * 3];
+      GColor   c  = on_display(x, y) ? read_pixel(x, y) : GColorBlack;
+      px[0] = ((c.argb >> 4) & 3) * 85;
+      px[1] = ((c.argb >> 2) & 3) * 85;
+      px[2] = (c.argb & 3) * 85;
+    }
+  }
+}
+
+const char* host_call_name(HostCall call) {
+  static const char *NAMES[HostCallCount] = {
+    "pixel", "line", "thick_line", "circle", "fill_circle",
+    "round_rect", "fill_rect", "text", "gpath", "bitmap",
+  };
+  return NAMES[call];
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+Per-module memory footprint from the linker map.
+
+Sums each src/c module's input sections in build/<platform>/pebble-app.map
+into code (.text, .rodata) and RAM data (.data, .bss). A Pebble app is loaded
+into RAM whole, so both count against the platform's app budget, together
+with whatever the heap needs at run time (WATCHFACE_PROFILE=1 logs that after
+window load).
+
+    tools/mem_report.py                     # every platform in build/
+    tools/mem_report.py --platforms aplite
+
+wscript runs this after `pebble build` when WATCHFACE_MEMORY_REPORT=1.
+"""
+import argparse
+import os
+import re
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# App RAM budget (code + data + heap) per platform, in bytes
+APP_RAM = {
+    'aplite':  24 * 1024,
+    'basalt':  64 * 1024,
+    'chalk':   64 * 1024,
+    'diorite': 64 * 1024,
+    'emery':   128 * 1024,
+    'flint':   64 * 1024,
+    'gabbro':  128 * 1024,
+}
+
+# ' .bss.s_face_bitmap  0x20000a10  0x4 src/c/layer_face.c.18.o', where a long
+# section name pushes the address, size and object onto the next line
+SECTION_RE = re.compile(r'^ (?P<section>\.[\w.$]+|COMMON)(?:\s+0x[0-9a-f]+\s+0x(?P<size>[0-9a-f]+)'
+                        r'\s+(?P<object>\S+\.o))?\s*$')
+CONTINUATION_RE = re.compile(r'^\s+0x[0-9a-f]+\s+0x(?P<size>[0-9a-f]+)\s+(?P<object>\S+\.o)\s*$')
+MODULE_RE = re.compile(r'src/c/(?P<module>\w+)\.c(?:\.\d+)?\.o$')
+
+
+def section_kind(section):
+    if section.startswith(('.text', '.rodata')):
+        return 'code'
+    if section.startswith(('.data', '.bss')) or section == 'COMMON':
+        return 'data'
+    return None
+
+
+def module_sizes(map_text):
+    """Returns {module: {'code': bytes, 'data': bytes}} for the src/c objects in a map."""
+    sizes, pending = {}, None
+    in_map = False
+    for line in map_text.splitlines():
+        if not in_map:
+            in_map = line.startswith('Linker script and memory map')
+            continue
+        m = SECTION_RE.match(line)
+        if m:
+            if m.group('size') is None:
+                pending = m.group('section')
+                continue
+            section, size, obj = m.group('section'), m.group('size'), m.group('object')
+        else:
+            m = CONTINUATION_RE.match(line) if pending else None
+            if not m:
+                pending = None
+                continue
+            section, size, obj = pending, m.group('size'), m.group('object')
+        pending = None
+
+        kind = section_kind(section)
+        module = MODULE_RE.search(obj)
+        if kind and module:
+            entry = sizes.setdefault(module.group('module'), {'code': 0, 'data': 0})
+            entry[kind] += int(size, 16)
+    return sizes
+
+
+def format_report(platform, sizes):
+    out = ['%s: per-module footprint (bytes)' % platform]
+    out.append('  %-18s %7s %7s' % ('module', 'code', 'data'))
+    for module, entry in sorted(sizes.items(), key=lambda kv: -(kv[1]['code'] + kv[1]['data'])):
+        out.append('  %-18s %7d %7d' % (module, entry['code'], entry['data']))
+    code = sum(e['code'] for e in sizes.values())
+    data = sum(e['data'] for e in sizes.values())
+    out.append('  %-18s %7d %7d' % ('total', code, data))
+    budget = APP_RAM.get(platform)
+    if budget:
+        out.append('  %d of %d bytes of app RAM; the heap gets what the rest leaves' % (code + data, budget))
+    return '\n'.join(out)
+
+
+def report(build_dir, platform):
+    """Returns the report text for one platform, or None if it has no map file."""
+    path = os.path.join(build_dir, platform, 'pebble-app.map')
+    if not os.path.exists(path):
+        return None
+    with open(path) as f:
+        return format_report(platform, module_sizes(f.read()))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--platforms', nargs='+', default=None,
+                        help='platforms to report (default: every build/<platform>/pebble-app.map)')
+    args = parser.parse_args()
+
+    build_dir = os.path.join(ROOT, 'build')
+    platforms = args.platforms
+    if not platforms:
+        names = os.listdir(build_dir) if os.path.isdir(build_dir) else []
+        platforms = sorted(p for p in names if p in APP_RAM)
+    for platform in platforms:
+        text = report(build_dir, platform)
+        print(text if text else '%s: no pebble-app.map (run `pebble build` first)' % platform)
+
+
+if __name__ == '__main__':
+    main()